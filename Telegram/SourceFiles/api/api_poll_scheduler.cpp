@@ -0,0 +1,65 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "api/api_poll_scheduler.h"
+
+#include "core/application.h"
+
+namespace Api {
+namespace {
+
+constexpr auto kTick = crl::time(1000);
+constexpr auto kIdleTimeout = 5 * 60 * crl::time(1000);
+constexpr auto kIdleMultiplier = 4;
+constexpr auto kLogPeriod = 60 * crl::time(1000);
+
+} // namespace
+
+crl::time PollScheduler::period(crl::time base) const {
+	const auto idle = crl::now() - Core::App().lastNonIdleTime();
+	return (idle >= kIdleTimeout) ? (base * kIdleMultiplier) : base;
+}
+
+crl::time PollScheduler::delay(crl::time period) const {
+	const auto now = crl::now();
+	const auto when = now + std::max(period, crl::time(1));
+	return ((when + kTick - 1) / kTick) * kTick - now;
+}
+
+void PollScheduler::requested(PollKind kind, int items) {
+	const auto now = crl::now();
+	if (!_countingStarted) {
+		_countingStarted = now;
+	} else if (now - _countingStarted >= kLogPeriod) {
+		log(now);
+	}
+	auto &counter = _counters[int(kind)];
+	++counter.requests;
+	counter.items += items;
+}
+
+void PollScheduler::log(crl::time now) {
+	const auto minutes = (now - _countingStarted) / float64(kLogPeriod);
+	const auto perMinute = [&](PollKind kind) {
+		const auto &counter = _counters[int(kind)];
+		return u"%1 (%2 items)"_q.arg(
+			counter.requests / minutes,
+			0,
+			'f',
+			1
+		).arg(counter.items);
+	};
+	DEBUG_LOG(("Poll Scheduler: requests per minute - views: %1, "
+		"extended media: %2, reactions: %3."
+		).arg(perMinute(PollKind::Views)
+		).arg(perMinute(PollKind::ExtendedMedia)
+		).arg(perMinute(PollKind::Reactions)));
+	_countingStarted = now;
+	_counters = {};
+}
+
+} // namespace Api
@@ -0,0 +1,45 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+namespace Api {
+
+enum class PollKind {
+	Views,
+	ExtendedMedia,
+	Reactions,
+};
+
+// Shared timing for the periodic refreshes of visible messages.
+// Views, reactions and paid media are polled on common ticks, so that
+// requests from many open chats go out together instead of in separate
+// bursts, and less often while the user is idle.
+class PollScheduler final {
+public:
+	// Poll period stretched while the user is idle.
+	[[nodiscard]] crl::time period(crl::time base) const;
+
+	// Delay until the first common tick not earlier than `period` from now.
+	[[nodiscard]] crl::time delay(crl::time period) const;
+
+	void requested(PollKind kind, int items);
+
+private:
+	struct Counter {
+		int requests = 0;
+		int items = 0;
+	};
+
+	void log(crl::time now);
+
+	crl::time _countingStarted = 0;
+	std::array<Counter, 3> _counters;
+
+};
+
+} // namespace Api
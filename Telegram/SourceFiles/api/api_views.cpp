@@ -7,6 +7,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 */
 #include "api/api_views.h"
 
+#include "api/api_poll_scheduler.h"
 #include "apiwrap.h"
 #include "data/data_peer.h"
 #include "data/data_peer_id.h"
@@ -46,7 +47,7 @@ void ViewsManager::scheduleIncrement(not_null<HistoryItem*> item) {
 	auto j = _toIncrement.find(peer);
 	if (j == _toIncrement.cend()) {
 		j = _toIncrement.emplace(peer).first;
-		_incrementTimer.callOnce(kSendViewsTimeout);
+		_incrementTimer.callOnce(scheduler().delay(kSendViewsTimeout));
 	}
 	j->second.emplace(item->id);
 }
@@ -73,7 +74,7 @@ void ViewsManager::pollExtendedMedia(
 	if (force) {
 		request.forced = true;
 	}
-	const auto delay = force ? 1 : kPollExtendedMediaPeriod;
+	const auto delay = pollDelay(force);
 	if (!request.id && (!request.when || force)) {
 		request.when = crl::now() + delay;
 	}
@@ -82,6 +83,16 @@ void ViewsManager::pollExtendedMedia(
 	}
 }
 
+PollScheduler &ViewsManager::scheduler() const {
+	return _session->api().pollScheduler();
+}
+
+crl::time ViewsManager::pollDelay(bool forced) const {
+	return forced
+		? 1
+		: scheduler().delay(scheduler().period(kPollExtendedMediaPeriod));
+}
+
 void ViewsManager::viewsIncrement() {
 	for (auto i = _toIncrement.begin(); i != _toIncrement.cend();) {
 		if (_incrementRequests.contains(i->first)) {
@@ -105,6 +116,7 @@ void ViewsManager::viewsIncrement() {
 		}).fail([=](const MTP::Error &error, mtpRequestId requestId) {
 			fail(error, requestId);
 		}).afterDelay(5).send();
+		scheduler().requested(PollKind::Views, ids.size());
 
 		_incrementRequests.emplace(i->first, requestId);
 		i = _toIncrement.erase(i);
@@ -168,9 +180,7 @@ void ViewsManager::sendPollRequests(
 					if (i->second.ids.empty()) {
 						i = _pollRequests.erase(i);
 					} else {
-						const auto delay = i->second.forced
-							? 1
-							: kPollExtendedMediaPeriod;
+						const auto delay = pollDelay(i->second.forced);
 						i->second.when = now + delay;
 						if (!_pollTimer.isActive() || i->second.forced) {
 							_pollTimer.callOnce(delay);
@@ -191,6 +201,7 @@ void ViewsManager::sendPollRequests(
 		}).fail([=](const MTP::Error &error, mtpRequestId id) {
 			finish(id);
 		}).send();
+		scheduler().requested(PollKind::ExtendedMedia, list.size());
 
 		_pollRequests[peer].id = requestId;
 	}
@@ -233,7 +244,7 @@ void ViewsManager::done(
 		}
 	}
 	if (!_toIncrement.empty() && !_incrementTimer.isActive()) {
-		_incrementTimer.callOnce(kSendViewsTimeout);
+		_incrementTimer.callOnce(scheduler().delay(kSendViewsTimeout));
 	}
 }
 
@@ -245,7 +256,7 @@ void ViewsManager::fail(const MTP::Error &error, mtpRequestId requestId) {
 		}
 	}
 	if (!_toIncrement.empty() && !_incrementTimer.isActive()) {
-		_incrementTimer.callOnce(kSendViewsTimeout);
+		_incrementTimer.callOnce(scheduler().delay(kSendViewsTimeout));
 	}
 }
 
@@ -19,6 +19,8 @@ class Session;
 
 namespace Api {
 
+class PollScheduler;
+
 class ViewsManager final {
 public:
 	explicit ViewsManager(not_null<ApiWrap*> api);
@@ -37,6 +39,9 @@ private:
 		bool forced = false;
 	};
 
+	[[nodiscard]] PollScheduler &scheduler() const;
+	[[nodiscard]] crl::time pollDelay(bool forced) const;
+
 	void viewsIncrement();
 	void sendPollRequests();
 	void sendPollRequests(
@@ -18,6 +18,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "api/api_media.h"
 #include "api/api_peer_colors.h"
 #include "api/api_peer_photo.h"
+#include "api/api_poll_scheduler.h"
 #include "api/api_polls.h"
 #include "api/api_sending.h"
 #include "api/api_text_entities.h"
@@ -181,6 +182,7 @@ ApiWrap::ApiWrap(not_null<Main::Session*> session)
 , _inviteLinks(std::make_unique<Api::InviteLinks>(this))
 , _chatLinks(std::make_unique<Api::ChatLinks>(this))
 , _views(std::make_unique<Api::ViewsManager>(this))
+, _pollScheduler(std::make_unique<Api::PollScheduler>())
 , _confirmPhone(std::make_unique<Api::ConfirmPhone>(this))
 , _peerPhoto(std::make_unique<Api::PeerPhoto>(this))
 , _polls(std::make_unique<Api::Polls>(this))
@@ -4933,6 +4935,10 @@ Api::ViewsManager &ApiWrap::views() {
 	return *_views;
 }
 
+Api::PollScheduler &ApiWrap::pollScheduler() {
+	return *_pollScheduler;
+}
+
 Api::ConfirmPhone &ApiWrap::confirmPhone() {
 	return *_confirmPhone;
 }
@@ -1123,8 +1123,8 @@ void PeerListContent::addRowEntry(not_null<PeerListRow*> row) {
 	if (!row->special()) {
 		_rowsByPeer[row->peer()].push_back(row);
 	}
-	if (addingToSearchIndex()) {
-		addToSearchIndex(row);
+	if (!row->isSearchResult()) {
+		invalidateSearchIndex();
 	}
 	if (_controller->isRowSelected(row)) {
 		Assert(row->special() || row->id() == row->peer()->id.value);
@@ -1138,37 +1138,24 @@ void PeerListContent::invalidatePixmapsCache() {
 	ranges::for_each(_searchRows, invalidate);
 }
 
-bool PeerListContent::addingToSearchIndex() const {
-	// If we started indexing already, we continue.
-	return (_searchMode != PeerListSearchMode::Disabled) || !_searchIndex.empty();
+void PeerListContent::invalidateSearchIndex() {
+	if (_searchIndexValid) {
+		_searchIndexValid = false;
+		_searchIndex.clear();
+	}
 }
 
-void PeerListContent::addToSearchIndex(not_null<PeerListRow*> row) {
-	if (row->isSearchResult()) {
+void PeerListContent::validateSearchIndex() {
+	// Built only when searched, so that large lists don't pay for keeping
+	// it in sync with every appended, removed or reordered row.
+	if (_searchIndexValid) {
 		return;
 	}
-
-	removeFromSearchIndex(row);
-	row->setNameFirstLetters(row->generateNameFirstLetters());
-	for (auto ch : row->nameFirstLetters()) {
-		_searchIndex[ch].push_back(row);
-	}
-}
-
-void PeerListContent::removeFromSearchIndex(not_null<PeerListRow*> row) {
-	const auto &nameFirstLetters = row->nameFirstLetters();
-	if (!nameFirstLetters.empty()) {
-		for (auto ch : row->nameFirstLetters()) {
-			auto it = _searchIndex.find(ch);
-			if (it != _searchIndex.cend()) {
-				auto &entry = it->second;
-				entry.erase(ranges::remove(entry, row), end(entry));
-				if (entry.empty()) {
-					_searchIndex.erase(it);
-				}
-			}
+	_searchIndexValid = true;
+	for (const auto &row : _rows) {
+		for (const auto ch : row->generateNameFirstLetters()) {
+			_searchIndex[ch].push_back(row.get());
 		}
-		row->setNameFirstLetters({});
 	}
 }
 
@@ -1204,9 +1191,7 @@ void PeerListContent::prependRowFromSearchResult(not_null<PeerListRow*> row) {
 	refreshIndices();
 	removeRowAtIndex(_searchRows, index);
 
-	if (addingToSearchIndex()) {
-		addToSearchIndex(row);
-	}
+	invalidateSearchIndex();
 }
 
 void PeerListContent::refreshIndices() {
@@ -1267,7 +1252,7 @@ void PeerListContent::removeRow(not_null<PeerListRow*> row) {
 		auto &byPeer = _rowsByPeer[row->peer()];
 		byPeer.erase(ranges::remove(byPeer, row), end(byPeer));
 	}
-	removeFromSearchIndex(row);
+	invalidateSearchIndex();
 	_filterResults.erase(
 		ranges::remove(_filterResults, row),
 		end(_filterResults));
@@ -1288,7 +1273,7 @@ void PeerListContent::clearAllContent() {
 	_rowsById.clear();
 	_rowsByPeer.clear();
 	_filterResults.clear();
-	_searchIndex.clear();
+	invalidateSearchIndex();
 	_rows.clear();
 	_searchRows.clear();
 	_searchQuery
@@ -1310,7 +1295,7 @@ void PeerListContent::convertRowToSearchResult(not_null<PeerListRow*> row) {
 	Assert(index >= 0 && index < _rows.size());
 	Assert(_rows[index].get() == row);
 
-	removeFromSearchIndex(row);
+	invalidateSearchIndex();
 	row->setIsSearchResult(true);
 	row->setHidden(false);
 	row->setAbsoluteIndex(_searchRows.size());
@@ -1441,11 +1426,6 @@ void PeerListContent::refreshRows() {
 
 void PeerListContent::setSearchMode(PeerListSearchMode mode) {
 	if (_searchMode != mode) {
-		if (!addingToSearchIndex()) {
-			for (const auto &row : _rows) {
-				addToSearchIndex(row.get());
-			}
-		}
 		_searchMode = mode;
 		if (_controller->hasComplexSearch()) {
 			if (_mode == Mode::Custom) {
@@ -2106,6 +2086,7 @@ void PeerListContent::searchQueryChanged(QString query) {
 		if (_controller->searchInLocal() && !searchWordsList.isEmpty()) {
 			Assert(_hiddenRows.empty() || _ignoreHiddenRowsOnSearch);
 
+			validateSearchIndex();
 			auto minimalList = (const std::vector<not_null<PeerListRow*>>*)nullptr;
 			for (const auto &searchWord : searchWordsList) {
 				auto searchWordStart = searchWord[0].toLower();
@@ -2449,10 +2430,8 @@ PeerListContent::RowIndex PeerListContent::findRowIndex(
 void PeerListContent::handleNameChanged(not_null<PeerData*> peer) {
 	auto byPeer = _rowsByPeer.find(peer);
 	if (byPeer != _rowsByPeer.cend()) {
+		invalidateSearchIndex();
 		for (auto row : byPeer->second) {
-			if (addingToSearchIndex()) {
-				addToSearchIndex(row);
-			}
 			row->refreshName(_st.item);
 			updateRow(row);
 		}
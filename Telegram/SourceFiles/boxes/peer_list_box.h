@@ -254,13 +254,6 @@ public:
 		int outerWidth);
 	float64 checkedRatio();
 
-	void setNameFirstLetters(const base::flat_set<QChar> &firstLetters) {
-		_nameFirstLetters = firstLetters;
-	}
-	const base::flat_set<QChar> &nameFirstLetters() const {
-		return _nameFirstLetters;
-	}
-
 	void setSkipPeerBadge(bool skip) {
 		_skipPeerBadge = skip;
 	}
@@ -305,7 +298,6 @@ private:
 	Ui::PeerBadge _badge;
 	StatusType _statusType = StatusType::Online;
 	crl::time _statusValidTill = 0;
-	base::flat_set<QChar> _nameFirstLetters;
 	QString _savedMessagesStatus;
 	int _absoluteIndex = -1;
 	State _disabledState = State::Active;
@@ -711,9 +703,7 @@ public:
 	template <typename ReorderCallback>
 	void reorderRows(ReorderCallback &&callback) {
 		callback(_rows.begin(), _rows.end());
-		for (auto &searchEntity : _searchIndex) {
-			callback(searchEntity.second.begin(), searchEntity.second.end());
-		}
+		invalidateSearchIndex();
 		refreshIndices();
 		if (!_hiddenRows.empty()) {
 			callback(_filterResults.begin(), _filterResults.end());
@@ -836,9 +826,8 @@ private:
 	crl::time paintRow(Painter &p, crl::time now, RowIndex index);
 
 	void addRowEntry(not_null<PeerListRow*> row);
-	void addToSearchIndex(not_null<PeerListRow*> row);
-	bool addingToSearchIndex() const;
-	void removeFromSearchIndex(not_null<PeerListRow*> row);
+	void invalidateSearchIndex();
+	void validateSearchIndex();
 	void setSearchQuery(const QString &query, const QString &normalizedQuery);
 	bool showingSearch() const {
 		return !_hiddenRows.empty() || !_searchQuery.isEmpty();
@@ -885,6 +874,7 @@ private:
 	std::map<PeerData*, std::vector<not_null<PeerListRow*>>> _rowsByPeer;
 
 	std::map<QChar, std::vector<not_null<PeerListRow*>>> _searchIndex;
+	bool _searchIndexValid = false;
 	QString _searchQuery;
 	QString _normalizedSearchQuery;
 	QString _mentionHighlight;
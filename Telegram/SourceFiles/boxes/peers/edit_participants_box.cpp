@@ -1125,7 +1125,7 @@ auto ParticipantsBoxController::saveState() const
 	auto my = std::make_unique<SavedState>(_additional);
 	my->offset = _offset;
 	my->allLoaded = _allLoaded;
-	my->wasLoading = (_loadRequestId != 0);
+	my->wasLoading = (_loadRequestId != 0) || _prefetchWanted;
 	if (const auto search = searchController()) {
 		my->searchState = search->saveState();
 	}
@@ -1182,6 +1182,7 @@ void ParticipantsBoxController::restoreState(
 		if (const auto requestId = base::take(_loadRequestId)) {
 			_api.request(requestId).cancel();
 		}
+		cancelPrefetch();
 
 		_additional = std::move(my->additional);
 		_offset = my->offset;
@@ -1319,6 +1320,7 @@ void ParticipantsBoxController::unload() {
 	if (const auto requestId = base::take(_loadRequestId)) {
 		_api.request(requestId).cancel();
 	}
+	cancelPrefetch();
 	_allLoaded = false;
 	_offset = 0;
 }
@@ -1500,11 +1502,20 @@ void ParticipantsBoxController::loadMoreRows() {
 		return;
 	}
 
-	const auto channel = _peer->asChannel();
 	if (feedMegagroupLastParticipants()) {
 		return;
+	} else if (_prefetched) {
+		applyParticipants(*base::take(_prefetched));
+		return;
+	} else if (_prefetchRequestId) {
+		_prefetchWanted = true;
+		return;
 	}
+	requestParticipants(false);
+}
 
+void ParticipantsBoxController::requestParticipants(bool prefetch) {
+	const auto channel = _peer->asChannel();
 	const auto filter = [&] {
 		if (_role == Role::Members || _role == Role::Profile) {
 			return MTP_channelParticipantsRecent();
@@ -1522,62 +1533,96 @@ void ParticipantsBoxController::loadMoreRows() {
 		: kParticipantsFirstPageCount;
 	const auto participantsHash = uint64(0);
 
-	_loadRequestId = _api.request(MTPchannels_GetParticipants(
+	const auto requestId = _api.request(MTPchannels_GetParticipants(
 		channel->inputChannel,
 		filter,
 		MTP_int(_offset),
 		MTP_int(perPage),
 		MTP_long(participantsHash)
 	)).done([=](const MTPchannels_ChannelParticipants &result) {
-		auto added = false;
-		const auto firstLoad = !_offset;
-		_loadRequestId = 0;
+		if (prefetch) {
+			_prefetchRequestId = 0;
+			_prefetched = result;
+			if (base::take(_prefetchWanted)) {
+				loadMoreRows();
+			}
+		} else {
+			_loadRequestId = 0;
+			applyParticipants(result);
+		}
+	}).fail([=] {
+		if (prefetch) {
+			_prefetchRequestId = 0;
+			_prefetchWanted = false;
+		} else {
+			_loadRequestId = 0;
+		}
+	}).send();
+	(prefetch ? _prefetchRequestId : _loadRequestId) = requestId;
+}
+
+void ParticipantsBoxController::applyParticipants(
+		const MTPchannels_ChannelParticipants &result) {
+	const auto channel = _peer->asChannel();
+	auto added = false;
+	const auto firstLoad = !_offset;
 
-		auto wasRecentRequest = firstLoad
-			&& (_role == Role::Members || _role == Role::Profile)
-			&& channel->canViewMembers();
+	auto wasRecentRequest = firstLoad
+		&& (_role == Role::Members || _role == Role::Profile)
+		&& channel->canViewMembers();
 
-		result.match([&](const MTPDchannels_channelParticipants &data) {
-			const auto &[availableCount, list] = wasRecentRequest
-				? Api::ChatParticipants::ParseRecent(channel, data)
-				: Api::ChatParticipants::Parse(channel, data);
-			for (const auto &data : list) {
-				if (const auto participant = _additional.applyParticipant(
-						data)) {
-					if (appendRow(participant)) {
-						added = true;
-					}
+	result.match([&](const MTPDchannels_channelParticipants &data) {
+		const auto &[availableCount, list] = wasRecentRequest
+			? Api::ChatParticipants::ParseRecent(channel, data)
+			: Api::ChatParticipants::Parse(channel, data);
+		for (const auto &data : list) {
+			if (const auto participant = _additional.applyParticipant(
+					data)) {
+				if (appendRow(participant)) {
+					added = true;
 				}
 			}
-			if (const auto size = list.size()) {
-				_offset += size;
-			} else {
-				// To be sure - wait for a whole empty result list.
-				_allLoaded = true;
-			}
-		}, [](const MTPDchannels_channelParticipantsNotModified &) {
-			LOG(("API Error: "
-				"channels.channelParticipantsNotModified received!"));
-		});
-		if (_offset > 0 && _role == Role::Admins && channel->isMegagroup()) {
-			if (channel->mgInfo->admins.empty() && channel->mgInfo->adminsLoaded) {
-				channel->mgInfo->adminsLoaded = false;
-			}
 		}
-		if (!firstLoad && !added) {
+		if (const auto size = list.size()) {
+			_offset += size;
+		} else {
+			// To be sure - wait for a whole empty result list.
 			_allLoaded = true;
 		}
-		if (_allLoaded
-			|| (firstLoad && delegate()->peerListFullRowsCount() > 0)) {
-			refreshDescription();
-		}
-		if (_onlineSorter) {
-			_onlineSorter->sort();
+	}, [](const MTPDchannels_channelParticipantsNotModified &) {
+		LOG(("API Error: "
+			"channels.channelParticipantsNotModified received!"));
+	});
+	if (_offset > 0 && _role == Role::Admins && channel->isMegagroup()) {
+		if (channel->mgInfo->admins.empty() && channel->mgInfo->adminsLoaded) {
+			channel->mgInfo->adminsLoaded = false;
 		}
-		refreshRows();
-	}).fail([this] {
-		_loadRequestId = 0;
-	}).send();
+	}
+	if (!firstLoad && !added) {
+		_allLoaded = true;
+	}
+	if (_allLoaded
+		|| (firstLoad && delegate()->peerListFullRowsCount() > 0)) {
+		refreshDescription();
+	}
+	if (_onlineSorter) {
+		_onlineSorter->sort();
+	}
+	refreshRows();
+
+	// Fetch the next page while this one is being scrolled through,
+	// so that large member lists don't stall on every page boundary.
+	if (!_allLoaded && !firstLoad) {
+		requestParticipants(true);
+	}
+}
+
+void ParticipantsBoxController::cancelPrefetch() {
+	if (const auto requestId = base::take(_prefetchRequestId)) {
+		_api.request(requestId).cancel();
+	}
+	_prefetched = std::nullopt;
+	_prefetchWanted = false;
 }
 
 void ParticipantsBoxController::refreshDescription() {
@@ -280,6 +280,9 @@ private:
 	bool removeRow(not_null<PeerData*> participant);
 	void refreshCustomStatus(not_null<PeerListRow*> row) const;
 	bool feedMegagroupLastParticipants();
+	void requestParticipants(bool prefetch);
+	void applyParticipants(const MTPchannels_ChannelParticipants &result);
+	void cancelPrefetch();
 	Type computeType(not_null<PeerData*> participant) const;
 	void recomputeTypeFor(not_null<PeerData*> participant);
 
@@ -297,6 +300,9 @@ private:
 	Role _role = Role::Admins;
 	int _offset = 0;
 	mtpRequestId _loadRequestId = 0;
+	mtpRequestId _prefetchRequestId = 0;
+	std::optional<MTPchannels_ChannelParticipants> _prefetched;
+	bool _prefetchWanted = false;
 	bool _allLoaded = false;
 	ParticipantsAdditionalData _additional;
 	std::unique_ptr<ParticipantsOnlineSorter> _onlineSorter;
@@ -23,6 +23,8 @@ namespace Calls::Group {
 namespace {
 
 constexpr auto kBlurRadius = 15;
+constexpr auto kUserpicBlurDownscale = 4;
+constexpr auto kUserpicBlurMinSize = 90;
 
 } // namespace
 
@@ -75,14 +77,22 @@ void Viewport::RendererSW::validateUserpicFrame(
 	} else if (!data.userpicFrame.isNull()) {
 		return;
 	}
-	const auto size = tile->trackOrUserpicSize();
+	// The blurred userpic is stretched to the tile anyway, so there is
+	// no need to generate and blur it in the full video track size.
+	const auto full = tile->trackOrUserpicSize().width();
+	const auto side = (full > kUserpicBlurMinSize)
+		? std::max(full / kUserpicBlurDownscale, kUserpicBlurMinSize)
+		: full;
+	const auto radius = (side < full)
+		? std::max(kBlurRadius * side / full, 1)
+		: kBlurRadius;
 	data.userpicFrame = Images::BlurLargeImage(
 		PeerData::GenerateUserpicImage(
 			tile->row()->peer(),
 			tile->row()->ensureUserpicView(),
-			size.width(),
+			side,
 			0),
-		kBlurRadius);
+		radius);
 }
 
 void Viewport::RendererSW::paintTile(
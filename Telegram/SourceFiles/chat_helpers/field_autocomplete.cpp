@@ -241,6 +241,17 @@ FieldAutocomplete::FieldAutocomplete(
 	) | rpl::start_with_next(crl::guard(_inner, [=] {
 		_inner->onParentGeometryChanged();
 	}), lifetime());
+
+	using PeerUpdateFlag = Data::PeerUpdate::Flag;
+	_session->changes().peerUpdates(
+		PeerUpdateFlag::Name
+		| PeerUpdateFlag::Username
+		| PeerUpdateFlag::Usernames
+		| PeerUpdateFlag::Members
+		| PeerUpdateFlag::Admins
+	) | rpl::start_with_next([=] {
+		_mentionsCache = MentionsCache();
+	}, lifetime());
 }
 
 std::shared_ptr<Show> FieldAutocomplete::uiShow() const {
@@ -429,7 +440,7 @@ FieldAutocomplete::StickerRows FieldAutocomplete::getStickerSuggestions() {
 }
 
 void FieldAutocomplete::updateFiltered(bool resetScroll) {
-	int32 now = base::unixtime::now(), recentInlineBots = 0;
+	auto recentInlineBots = 0;
 	MentionRows mrows;
 	HashtagRows hrows;
 	BotCommandRows brows;
@@ -437,20 +448,6 @@ void FieldAutocomplete::updateFiltered(bool resetScroll) {
 	if (_emoji) {
 		srows = getStickerSuggestions();
 	} else if (_type == Type::Mentions) {
-		int maxListSize = _addInlineBots ? cRecentInlineBots().size() : 0;
-		if (_chat) {
-			maxListSize += (_chat->participants.empty() ? _chat->lastAuthors.size() : _chat->participants.size());
-		} else if (_channel && _channel->isMegagroup()) {
-			if (!_channel->canViewMembers()) {
-				maxListSize += _channel->mgInfo->admins.size();
-			} else if (!_channel->lastParticipantsRequestNeeded()) {
-				maxListSize += _channel->mgInfo->lastParticipants.size();
-			}
-		}
-		if (maxListSize) {
-			mrows.reserve(maxListSize);
-		}
-
 		auto filterNotPassedByUsername = [this](UserData *user) -> bool {
 			if (PrimaryUsername(user).startsWith(_filter, Qt::CaseInsensitive)) {
 				const auto exactUsername
@@ -459,17 +456,6 @@ void FieldAutocomplete::updateFiltered(bool resetScroll) {
 			}
 			return true;
 		};
-		auto filterNotPassedByName = [&](UserData *user) -> bool {
-			for (const auto &nameWord : user->nameWords()) {
-				if (nameWord.startsWith(_filter, Qt::CaseInsensitive)) {
-					const auto exactUsername = PrimaryUsername(user).compare(
-						_filter,
-						Qt::CaseInsensitive) == 0;
-					return exactUsername;
-				}
-			}
-			return filterNotPassedByUsername(user);
-		};
 
 		bool listAllSuggestions = _filter.isEmpty();
 		if (_addInlineBots) {
@@ -483,60 +469,18 @@ void FieldAutocomplete::updateFiltered(bool resetScroll) {
 				++recentInlineBots;
 			}
 		}
-		if (_chat) {
-			auto sorted = base::flat_multi_map<TimeId, not_null<UserData*>>();
-			const auto byOnline = [&](not_null<UserData*> user) {
-				return Data::SortByOnlineValue(user, now);
-			};
-			mrows.reserve(mrows.size() + (_chat->participants.empty() ? _chat->lastAuthors.size() : _chat->participants.size()));
-			if (_chat->noParticipantInfo()) {
-				_chat->session().api().requestFullPeer(_chat);
-			} else if (!_chat->participants.empty()) {
-				for (const auto &user : _chat->participants) {
-					if (user->isInaccessible()) continue;
-					if (!listAllSuggestions && filterNotPassedByName(user)) continue;
-					if (indexOfInFirstN(mrows, user, recentInlineBots) >= 0) continue;
-					sorted.emplace(byOnline(user), user);
-				}
-			}
-			for (const auto user : _chat->lastAuthors) {
-				if (user->isInaccessible()) continue;
-				if (!listAllSuggestions && filterNotPassedByName(user)) continue;
-				if (indexOfInFirstN(mrows, user, recentInlineBots) >= 0) continue;
-				mrows.push_back({ user });
-				sorted.remove(byOnline(user), user);
-			}
-			for (auto i = sorted.cend(), b = sorted.cbegin(); i != b;) {
-				--i;
-				mrows.push_back({ i->second });
-			}
-		} else if (_channel && _channel->isMegagroup()) {
-			if (!_channel->canViewMembers()) {
-				if (!_channel->mgInfo->adminsLoaded) {
-					_channel->session().api().chatParticipants().requestAdmins(_channel);
-				} else {
-					mrows.reserve(mrows.size() + _channel->mgInfo->admins.size());
-					for (const auto &[userId, rank] : _channel->mgInfo->admins) {
-						if (const auto user = _channel->owner().userLoaded(userId)) {
-							if (user->isInaccessible()) continue;
-							if (!listAllSuggestions && filterNotPassedByName(user)) continue;
-							if (indexOfInFirstN(mrows, user, recentInlineBots) >= 0) continue;
-							mrows.push_back({ user });
-						}
-					}
-				}
-			} else if (_channel->lastParticipantsRequestNeeded()) {
-				_channel->session().api().chatParticipants().requestLast(
-					_channel);
-			} else {
-				mrows.reserve(mrows.size() + _channel->mgInfo->lastParticipants.size());
-				for (const auto user : _channel->mgInfo->lastParticipants) {
-					if (user->isInaccessible()) continue;
-					if (!listAllSuggestions && filterNotPassedByName(user)) continue;
-					if (indexOfInFirstN(mrows, user, recentInlineBots) >= 0) continue;
-					mrows.push_back({ user });
-				}
+		const auto &users = mentionCandidates();
+		mrows.reserve(mrows.size() + users.size());
+		for (const auto user : users) {
+			if (user->isInaccessible()) continue;
+			if (!listAllSuggestions
+				&& !PrimaryUsername(user).compare(
+					_filter,
+					Qt::CaseInsensitive)) {
+				continue;
 			}
+			if (indexOfInFirstN(mrows, user, recentInlineBots) >= 0) continue;
+			mrows.push_back({ user });
 		}
 	} else if (_type == Type::Hashtags) {
 		bool listAllSuggestions = _filter.isEmpty();
@@ -689,6 +633,114 @@ void FieldAutocomplete::updateFiltered(bool resetScroll) {
 	_inner->setRecentInlineBotsInRows(recentInlineBots);
 }
 
+auto FieldAutocomplete::mentionCandidates()
+-> const std::vector<not_null<UserData*>> & {
+	const auto peer = _chat
+		? static_cast<PeerData*>(_chat)
+		: static_cast<PeerData*>(_channel);
+	auto &cache = _mentionsCache;
+	const auto matches = [&](not_null<UserData*> user) {
+		if (_filter.isEmpty()
+			|| PrimaryUsername(user).startsWith(
+				_filter,
+				Qt::CaseInsensitive)) {
+			return true;
+		}
+		for (const auto &nameWord : user->nameWords()) {
+			if (nameWord.startsWith(_filter, Qt::CaseInsensitive)) {
+				return true;
+			}
+		}
+		return false;
+	};
+
+	// Each keystroke usually only appends to the query, so narrow down
+	// the users that matched the previous query instead of the sources.
+	if (peer
+		&& cache.peer == peer
+		&& _filter.startsWith(cache.filter)) {
+		if (_filter.size() != cache.filter.size()) {
+			cache.users.erase(
+				ranges::remove_if(cache.users, [&](not_null<UserData*> u) {
+					return !matches(u);
+				}),
+				end(cache.users));
+			cache.filter = _filter;
+		}
+		return cache.users;
+	}
+	cache = MentionsCache();
+	auto &users = cache.users;
+	if (_chat) {
+		if (_chat->noParticipantInfo()) {
+			_chat->session().api().requestFullPeer(_chat);
+
+			// Not cached, the list is rebuilt once participants arrive.
+			for (const auto user : _chat->lastAuthors) {
+				if (matches(user)) {
+					users.push_back(user);
+				}
+			}
+			return users;
+		}
+		auto sorted = base::flat_multi_map<TimeId, not_null<UserData*>>();
+		const auto now = base::unixtime::now();
+		const auto byOnline = [&](not_null<UserData*> user) {
+			return Data::SortByOnlineValue(user, now);
+		};
+		for (const auto &user : _chat->participants) {
+			if (matches(user)) {
+				sorted.emplace(byOnline(user), user);
+			}
+		}
+		users.reserve(_chat->lastAuthors.size() + sorted.size());
+		for (const auto user : _chat->lastAuthors) {
+			if (matches(user)) {
+				users.push_back(user);
+				sorted.remove(byOnline(user), user);
+			}
+		}
+		for (auto i = sorted.cend(), b = sorted.cbegin(); i != b;) {
+			--i;
+			users.push_back(i->second);
+		}
+	} else if (_channel && _channel->isMegagroup()) {
+		if (!_channel->canViewMembers()) {
+			if (!_channel->mgInfo->adminsLoaded) {
+				_channel->session().api().chatParticipants().requestAdmins(
+					_channel);
+				return users;
+			}
+			const auto &admins = _channel->mgInfo->admins;
+			users.reserve(admins.size());
+			for (const auto &[userId, rank] : admins) {
+				if (const auto user = _channel->owner().userLoaded(userId)) {
+					if (matches(user)) {
+						users.push_back(user);
+					}
+				}
+			}
+		} else if (_channel->lastParticipantsRequestNeeded()) {
+			_channel->session().api().chatParticipants().requestLast(
+				_channel);
+			return users;
+		} else {
+			const auto &list = _channel->mgInfo->lastParticipants;
+			users.reserve(list.size());
+			for (const auto user : list) {
+				if (matches(user)) {
+					users.push_back(user);
+				}
+			}
+		}
+	} else {
+		return users;
+	}
+	cache.peer = peer;
+	cache.filter = _filter;
+	return users;
+}
+
 void FieldAutocomplete::rowsUpdated(
 		MentionRows &&mrows,
 		HashtagRows &&hrows,
@@ -790,6 +842,7 @@ void FieldAutocomplete::hideFinish() {
 	hide();
 	_hiding = false;
 	_filter = u"-"_q;
+	_mentionsCache = MentionsCache();
 	_inner->clearSel(true);
 }
 
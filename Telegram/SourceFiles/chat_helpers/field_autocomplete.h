@@ -159,12 +159,22 @@ private:
 	using StickerRows = std::vector<StickerSuggestion>;
 	using MentionRows = std::vector<MentionRow>;
 
+	// Users of the current chat matching the current mention query,
+	// in the order they're suggested, before inline bots are added.
+	struct MentionsCache {
+		PeerData *peer = nullptr;
+		QString filter;
+		std::vector<not_null<UserData*>> users;
+	};
+
 	void animationCallback();
 	void hideFinish();
 
 	void updateFiltered(bool resetScroll = false);
 	void recount(bool resetScroll = false);
 	StickerRows getStickerSuggestions();
+	[[nodiscard]] auto mentionCandidates()
+		-> const std::vector<not_null<UserData*>> &;
 
 	const std::shared_ptr<Show> _show;
 	const not_null<Main::Session*> _session;
@@ -192,6 +202,7 @@ private:
 	uint64 _stickersSeed = 0;
 	Type _type = Type::Mentions;
 	QString _filter;
+	MentionsCache _mentionsCache;
 	QRect _boundings;
 	bool _addInlineBots;
 
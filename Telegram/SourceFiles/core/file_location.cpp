@@ -11,12 +11,224 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "logs.h"
 
 #include <QtCore/QFileInfo>
+#include <QtCore/QFileSystemWatcher>
+#include <QtCore/QMutex>
 
 namespace Core {
 namespace {
 
 const auto kInMediaCacheLocation = u"*media_cache*"_q;
 constexpr auto kMaxFileSize = 4000 * int64(1024 * 1024);
+constexpr auto kStatFreshTimeout = crl::time(2000);
+constexpr auto kStatStaleTimeout = 30 * crl::time(1000);
+constexpr auto kMaxCachedStats = 4096;
+constexpr auto kMaxWatchedDirectories = 64;
+
+struct Stat {
+	QString directory;
+	QDateTime modified;
+	qint64 size = 0;
+	crl::time when = 0;
+	bool readable = false;
+	bool refreshing = false;
+	bool cached = false;
+};
+
+// Results of file stats shared by all the locations with the same path.
+// Chat scrolling checks the same downloaded files over and over, which
+// blocks the main thread when the download folder is on a network drive.
+// Only readable results are kept, a missing file is checked every time.
+struct StatCache {
+	QMutex mutex;
+	base::flat_map<QString, Stat> stats;
+	base::flat_map<QString, int> directories; // Cached stats count.
+	base::flat_set<QString> watched;
+	QFileSystemWatcher *watcher = nullptr; // Owned by the application.
+	bool watchLimitLogged = false;
+};
+
+[[nodiscard]] StatCache &GlobalStatCache() {
+	static auto result = StatCache();
+	return result;
+}
+
+[[nodiscard]] Stat ReadStat(const QString &path) {
+	const auto info = QFileInfo(path);
+	auto result = Stat{
+		.directory = info.absolutePath(),
+		.when = crl::now(),
+		.readable = info.isReadable(),
+	};
+	if (result.readable) {
+		result.modified = info.lastModified();
+		result.size = info.size();
+	}
+	return result;
+}
+
+void InvalidateDirectory(const QString &directory);
+
+// Changes are reported only for local file systems, remote ones rely on
+// the cached stats expiring. Runs on the main thread, where the watcher
+// lives, and watches exactly the directories that have cached stats.
+void SyncWatched(const QString &directory) {
+	auto &cache = GlobalStatCache();
+	auto lock = QMutexLocker(&cache.mutex);
+	const auto used = cache.directories.contains(directory);
+	if (used == cache.watched.contains(directory)) {
+		return;
+	} else if (used
+		&& int(cache.watched.size()) >= kMaxWatchedDirectories) {
+		if (!cache.watchLimitLogged) {
+			cache.watchLimitLogged = true;
+			LOG(("File Stats: Watching %1 directories, "
+				"files in others are checked without a stale cache."
+				).arg(kMaxWatchedDirectories));
+		}
+		return;
+	} else if (used) {
+		cache.watched.emplace(directory);
+	} else {
+		cache.watched.remove(directory);
+	}
+
+	// A slot was freed, give it to a directory that is waiting for one.
+	auto waiting = QString();
+	if (!used) {
+		for (const auto &[path, count] : cache.directories) {
+			if (!cache.watched.contains(path)) {
+				waiting = path;
+				break;
+			}
+		}
+	}
+	lock.unlock();
+
+	const auto application = QCoreApplication::instance();
+	auto &watcher = cache.watcher;
+	if (!application) {
+		return;
+	} else if (!watcher) {
+		watcher = new QFileSystemWatcher(application);
+		QObject::connect(
+			watcher,
+			&QFileSystemWatcher::directoryChanged,
+			InvalidateDirectory);
+	}
+	if (used) {
+		watcher->addPath(directory);
+	} else {
+		watcher->removePath(directory);
+		if (!waiting.isEmpty()) {
+			SyncWatched(waiting);
+		}
+	}
+}
+
+void StatAdded(StatCache &cache, const QString &directory) {
+	if (++cache.directories[directory] == 1) {
+		crl::on_main([=] { SyncWatched(directory); });
+	}
+}
+
+void StatRemoved(StatCache &cache, const QString &directory) {
+	const auto i = cache.directories.find(directory);
+	if (i != end(cache.directories) && !--i->second) {
+		cache.directories.erase(i);
+		crl::on_main([=] { SyncWatched(directory); });
+	}
+}
+
+void ForgetStat(StatCache &cache, const QString &path) {
+	if (const auto i = cache.stats.find(path); i != end(cache.stats)) {
+		const auto directory = i->second.directory;
+		cache.stats.erase(i);
+		StatRemoved(cache, directory);
+	}
+}
+
+// Rebuilds the map instead of erasing the entries one by one,
+// so that dropping a lot of them doesn't take quadratic time.
+template <typename Predicate>
+void DropStats(StatCache &cache, Predicate &&drop) {
+	auto kept = base::flat_map<QString, Stat>();
+	for (auto &[path, stat] : cache.stats) {
+		if (drop(stat)) {
+			StatRemoved(cache, stat.directory);
+		} else {
+			kept.emplace(path, std::move(stat));
+		}
+	}
+	cache.stats = std::move(kept);
+}
+
+void InvalidateDirectory(const QString &directory) {
+	auto &cache = GlobalStatCache();
+	auto lock = QMutexLocker(&cache.mutex);
+	DropStats(cache, [&](const Stat &stat) {
+		return (stat.directory == directory);
+	});
+}
+
+void RememberStat(StatCache &cache, const QString &path, Stat stat) {
+	if (!stat.readable) {
+		ForgetStat(cache, path);
+		return;
+	}
+	auto &stats = cache.stats;
+	if (const auto i = stats.find(path); i != end(stats)) {
+		i->second = std::move(stat);
+		return;
+	}
+	if (stats.size() >= kMaxCachedStats) {
+		// Drop the stale entries, but at least the oldest quarter.
+		auto whens = stats | ranges::views::transform([](
+				const auto &pair) {
+			return pair.second.when;
+		}) | ranges::to_vector;
+		const auto oldest = begin(whens) + (kMaxCachedStats / 4);
+		ranges::nth_element(whens, oldest);
+		const auto till = std::max(*oldest, crl::now() - kStatStaleTimeout);
+		DropStats(cache, [&](const Stat &stat) {
+			return (stat.when <= till);
+		});
+	}
+	const auto directory = stat.directory;
+	stats.emplace(path, std::move(stat));
+	StatAdded(cache, directory);
+}
+
+Stat FreshStat(const QString &path) {
+	auto result = ReadStat(path);
+	auto &cache = GlobalStatCache();
+	auto lock = QMutexLocker(&cache.mutex);
+	RememberStat(cache, path, result);
+	return result;
+}
+
+[[nodiscard]] Stat CachedStat(const QString &path) {
+	auto &cache = GlobalStatCache();
+	auto lock = QMutexLocker(&cache.mutex);
+	if (const auto i = cache.stats.find(path); i != end(cache.stats)) {
+		auto &stat = i->second;
+		const auto age = crl::now() - stat.when;
+		const auto watched = cache.watched.contains(stat.directory);
+		if (age < kStatFreshTimeout
+			|| (age < kStatStaleTimeout && watched)) {
+			// A file that is gone fails on open anyway, so it is fine
+			// to report a watched one readable a bit longer.
+			if (age >= kStatFreshTimeout && !stat.refreshing) {
+				stat.refreshing = true;
+				crl::async([=] { FreshStat(path); });
+			}
+			auto result = stat;
+			result.cached = true;
+			return result;
+		}
+	}
+	lock.unlock();
+	return FreshStat(path);
+}
 
 } // namespace
 
@@ -80,27 +292,39 @@ bool FileLocation::check() const {
 		return false;
 	}
 
-	ReadAccessEnabler enabler(_bookmark);
-	if (enabler.failed()) {
-		const_cast<FileLocation*>(this)->_bookmark = nullptr;
-	}
-
-	QFileInfo f(name());
-	if (!f.isReadable()) return false;
-
-	quint64 s = f.size();
-	if (s > kMaxFileSize) {
-		DEBUG_LOG(("File location check: Wrong size %1").arg(s));
+	const auto stat = [&] {
+		if (_bookmark) {
+			ReadAccessEnabler enabler(_bookmark);
+			if (enabler.failed()) {
+				const_cast<FileLocation*>(this)->_bookmark = nullptr;
+			}
+			return ReadStat(name());
+		}
+		// Misses and mismatches are still read on the calling thread.
+		auto result = CachedStat(fname);
+		if (result.cached
+			&& (result.size != size || result.modified != modified)) {
+			// The file could be rewritten at the same path.
+			result = FreshStat(fname);
+		}
+		return result;
+	}();
+	if (!stat.readable) {
 		return false;
-	}
-
-	if (s != size) {
-		DEBUG_LOG(("File location check: Wrong size %1 when should be %2").arg(s).arg(size));
+	} else if (stat.size > kMaxFileSize) {
+		DEBUG_LOG(("File location check: Wrong size %1").arg(stat.size));
 		return false;
-	}
-	auto realModified = f.lastModified();
-	if (realModified != modified) {
-		DEBUG_LOG(("File location check: Wrong last modified time %1 when should be %2").arg(realModified.toMSecsSinceEpoch()).arg(modified.toMSecsSinceEpoch()));
+	} else if (stat.size != size) {
+		DEBUG_LOG(("File location check: "
+			"Wrong size %1 when should be %2"
+			).arg(stat.size
+			).arg(size));
+		return false;
+	} else if (stat.modified != modified) {
+		DEBUG_LOG(("File location check: "
+			"Wrong last modified time %1 when should be %2"
+			).arg(stat.modified.toMSecsSinceEpoch()
+			).arg(modified.toMSecsSinceEpoch()));
 		return false;
 	}
 	return true;
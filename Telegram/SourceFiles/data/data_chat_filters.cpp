@@ -339,8 +339,15 @@ const base::flat_set<not_null<History*>> &ChatFilter::never() const {
 bool ChatFilter::contains(
 		not_null<History*> history,
 		bool ignoreFakeUnread) const {
-	const auto flag = [&] {
-		const auto peer = history->peer;
+	return matches(history, RulesFor(history, _flags, ignoreFakeUnread));
+}
+
+ChatFilter::Flags ChatFilter::RulesFor(
+		not_null<History*> history,
+		Flags checked,
+		bool ignoreFakeUnread) {
+	const auto peer = history->peer;
+	auto result = Flags([&] {
 		if (const auto user = peer->asUser()) {
 			return user->isBot()
 				? Flag::Bots
@@ -356,28 +363,39 @@ bool ChatFilter::contains(
 				return Flag::Groups;
 			}
 		} else {
-			Unexpected("Peer type in ChatFilter::contains.");
+			Unexpected("Peer type in ChatFilter::RulesFor.");
+		}
+	}());
+	const auto notArchived = history->folderKnown() && !history->folder();
+	if (notArchived) {
+		result |= Flag::NoArchived;
+	}
+	if (checked & (Flag::NoMuted | Flag::NoRead)) {
+		const auto state = history->chatListBadgesState();
+		if (!history->muted() || (state.mention && notArchived)) {
+			result |= Flag::NoMuted;
 		}
-	}();
+		if (state.unread
+			|| state.mention
+			|| (!ignoreFakeUnread && history->fakeUnreadWhileOpened())) {
+			result |= Flag::NoRead;
+		}
+	}
+	return result;
+}
+
+bool ChatFilter::matches(not_null<History*> history, Flags rules) const {
 	if (_never.contains(history)) {
 		return false;
 	}
-	const auto state = (_flags & (Flag::NoMuted | Flag::NoRead))
-		? history->chatListBadgesState()
-		: Dialogs::BadgesState();
-	return false
-		|| ((_flags & flag)
-			&& (!(_flags & Flag::NoMuted)
-				|| !history->muted()
-				|| (state.mention
-					&& history->folderKnown()
-					&& !history->folder()))
-			&& (!(_flags & Flag::NoRead)
-				|| state.unread
-				|| state.mention
-				|| (!ignoreFakeUnread && history->fakeUnreadWhileOpened()))
-			&& (!(_flags & Flag::NoArchived)
-				|| (history->folderKnown() && !history->folder())))
+	const auto types = Flag::Contacts
+		| Flag::NonContacts
+		| Flag::Groups
+		| Flag::Channels
+		| Flag::Bots;
+	const auto required = _flags
+		& (Flag::NoMuted | Flag::NoRead | Flag::NoArchived);
+	return ((_flags & rules & types) && ((rules & required) == required))
 		|| _always.contains(history);
 }
 
@@ -738,9 +756,11 @@ bool ChatFilters::applyChange(ChatFilter &filter, ChatFilter &&updated) {
 				? false
 				: row->entry()->hasChatsFilterTags(0);
 		};
+		const auto checked = filter.flags() | wasFilter.flags();
 		const auto feedHistory = [&](not_null<History*> history) {
-			const auto now = filter.contains(history);
-			const auto was = wasFilter.contains(history);
+			const auto rules = ChatFilter::RulesFor(history, checked);
+			const auto now = filter.matches(history, rules);
+			const auto was = wasFilter.matches(history, rules);
 			if (now != was) {
 				if (now) {
 					history->addToChatList(id, filterList);
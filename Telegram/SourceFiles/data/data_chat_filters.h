@@ -100,6 +100,17 @@ public:
 		not_null<History*> history,
 		bool ignoreFakeUnread = false) const;
 
+	// Rules from RulesMask the history passes on its own, so that a change
+	// in the history is evaluated once and then checked against many
+	// filters by matches(). Only rules from the checked mask are computed.
+	[[nodiscard]] static Flags RulesFor(
+		not_null<History*> history,
+		Flags checked,
+		bool ignoreFakeUnread = false);
+	[[nodiscard]] bool matches(
+		not_null<History*> history,
+		Flags rules) const;
+
 private:
 	FilterId _id = 0;
 	TextWithEntities _title;
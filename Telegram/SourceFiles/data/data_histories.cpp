@@ -35,6 +35,7 @@ namespace Data {
 namespace {
 
 constexpr auto kReadRequestTimeout = 3 * crl::time(1000);
+constexpr auto kMaxReadRequestsInFlight = 4;
 constexpr auto kReportDeliveriesPerRequest = 50;
 
 } // namespace
@@ -677,19 +678,41 @@ void Histories::sendReadRequests() {
 	}
 	const auto now = crl::now();
 	auto next = std::optional<crl::time>();
+	auto ready = std::vector<std::pair<crl::time, not_null<History*>>>();
+	auto sending = 0;
 	for (auto &[history, state] : _states) {
+		if (state.sentReadTill && !state.sentReadDone) {
+			++sending;
+		}
 		if (!state.willReadTill) {
 			DEBUG_LOG(("Reading: skipping zero till."));
 			continue;
 		} else if (state.willReadWhen <= now) {
-			DEBUG_LOG(("Reading: sending with till %1."
-				).arg(state.willReadTill.bare));
-			sendReadRequest(history, state);
+			ready.emplace_back(state.willReadWhen, history);
 		} else if (!next || *next > state.willReadWhen) {
 			DEBUG_LOG(("Reading: scheduling for later send."));
 			next = state.willReadWhen;
 		}
 	}
+
+	// Reads without a delay come from the chat that is being read right
+	// now, send them first and then the ones postponed for the longest.
+	// The rest are sent when the requests in flight finish.
+	ranges::sort(ready);
+	const auto count = std::min(
+		int(ready.size()),
+		std::max(kMaxReadRequestsInFlight - sending, 0));
+	for (const auto &[when, history] : ready | ranges::views::take(count)) {
+		const auto state = lookup(history);
+		DEBUG_LOG(("Reading: sending with till %1."
+			).arg(state->willReadTill.bare));
+		sendReadRequest(history, *state);
+	}
+	if (count < ready.size()) {
+		DEBUG_LOG(("Reading: %1 requests in flight, %2 waiting."
+			).arg(sending + count
+			).arg(ready.size() - count));
+	}
 	if (next.has_value()) {
 		_readRequestsTimer.callOnce(*next - now);
 	} else {
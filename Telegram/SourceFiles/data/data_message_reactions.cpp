@@ -8,6 +8,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_message_reactions.h"
 
 #include "api/api_global_privacy.h"
+#include "api/api_poll_scheduler.h"
 #include "chat_helpers/stickers_lottie.h"
 #include "core/application.h"
 #include "history/history.h"
@@ -358,6 +359,7 @@ Reactions::Reactions(not_null<Session*> owner)
 : _owner(owner)
 , _topRefreshTimer([=] { refreshTop(); })
 , _repaintTimer([=] { repaintCollected(); })
+, _pollTimer([=] { pollCollected(); })
 , _sendPaidTimer([=] { sendPaid(); }) {
 	refreshDefault();
 
@@ -374,7 +376,10 @@ Reactions::Reactions(not_null<Session*> owner)
 		MessageUpdate::Flag::Destroyed
 	) | rpl::start_with_next([=](const MessageUpdate &update) {
 		const auto item = update.item;
-		_pollingItems.remove(item);
+		const auto polling = _pollingItems.find(item->history()->peer);
+		if (polling != end(_pollingItems)) {
+			polling->second.remove(item);
+		}
 		_pollItems.remove(item);
 		_repaintItems.remove(item);
 		_sendPaidItems.remove(item);
@@ -1522,27 +1527,32 @@ void Reactions::poll(not_null<HistoryItem*> item, crl::time now) {
 	// Group them by one second.
 	const auto last = item->lastReactionsRefreshTime();
 	const auto grouped = ((last + 999) / 1000) * 1000;
+	const auto &scheduler = _owner->session().api().pollScheduler();
+	const auto each = scheduler.period(kPollEach);
 	if (!grouped || item->history()->peer->isUser()) {
 		// First reaction always edits message.
 		return;
-	} else if (const auto left = grouped + kPollEach - now; left > 0) {
+	} else if (const auto left = grouped + each - now; left > 0) {
 		if (!_repaintItems.contains(item)) {
-			_repaintItems.emplace(item, grouped + kPollEach);
+			_repaintItems.emplace(item, grouped + each);
 			if (!_repaintTimer.isActive()
 				|| _repaintTimer.remainingTime() > left) {
 				_repaintTimer.callOnce(left);
 			}
 		}
-	} else if (!_pollingItems.contains(item)) {
-		if (_pollItems.empty() && !_pollRequestId) {
-			crl::on_main(&_owner->session(), [=] {
-				pollCollected();
-			});
-		}
+	} else if (!polling(item)) {
 		_pollItems.emplace(item);
+		if (!_pollTimer.isActive()) {
+			_pollTimer.callOnce(scheduler.delay(0));
+		}
 	}
 }
 
+bool Reactions::polling(not_null<HistoryItem*> item) const {
+	const auto i = _pollingItems.find(item->history()->peer);
+	return (i != end(_pollingItems)) && i->second.contains(item);
+}
+
 void Reactions::updateAllInHistory(not_null<PeerData*> peer, bool enabled) {
 	if (const auto history = _owner->historyLoaded(peer)) {
 		history->reactionsEnabledChanged(enabled);
@@ -1686,28 +1696,37 @@ void Reactions::repaintCollected() {
 
 void Reactions::pollCollected() {
 	auto toRequest = base::flat_map<not_null<PeerData*>, QVector<MTPint>>();
-	_pollingItems = std::move(_pollItems);
-	for (const auto &item : _pollingItems) {
-		toRequest[item->history()->peer].push_back(MTP_int(item->id));
+	for (auto i = begin(_pollItems); i != end(_pollItems);) {
+		const auto item = *i;
+		const auto peer = item->history()->peer;
+		if (_pollRequests.contains(peer)) {
+			// Wait for the previous request for this peer to finish.
+			++i;
+			continue;
+		}
+		_pollingItems[peer].emplace(item);
+		toRequest[peer].push_back(MTP_int(item->id));
+		i = _pollItems.erase(i);
 	}
 	auto &api = _owner->session().api();
 	for (const auto &[peer, ids] : toRequest) {
 		const auto finalize = [=] {
 			const auto now = crl::now();
-			for (const auto &item : base::take(_pollingItems)) {
-				const auto last = item->lastReactionsRefreshTime();
-				if (last && last + kPollEach <= now) {
-					item->updateReactions(nullptr);
+			if (const auto items = _pollingItems.take(peer)) {
+				for (const auto &item : *items) {
+					const auto last = item->lastReactionsRefreshTime();
+					if (last && last + kPollEach <= now) {
+						item->updateReactions(nullptr);
+					}
 				}
 			}
-			_pollRequestId = 0;
-			if (!_pollItems.empty()) {
-				crl::on_main(&_owner->session(), [=] {
-					pollCollected();
-				});
+			_pollRequests.remove(peer);
+			if (!_pollItems.empty() && !_pollTimer.isActive()) {
+				const auto &api = _owner->session().api();
+				_pollTimer.callOnce(api.pollScheduler().delay(0));
 			}
 		};
-		_pollRequestId = api.request(MTPmessages_GetMessagesReactions(
+		_pollRequests[peer] = api.request(MTPmessages_GetMessagesReactions(
 			peer->input,
 			MTP_vector<MTPint>(ids)
 		)).done([=](const MTPUpdates &result) {
@@ -1716,6 +1735,7 @@ void Reactions::pollCollected() {
 		}).fail([=] {
 			finalize();
 		}).send();
+		api.pollScheduler().requested(Api::PollKind::Reactions, ids.size());
 	}
 }
 
@@ -256,6 +256,7 @@ private:
 
 	void repaintCollected();
 	void pollCollected();
+	[[nodiscard]] bool polling(not_null<HistoryItem*> item) const;
 
 	void sendPaid();
 	bool sendPaid(not_null<HistoryItem*> item);
@@ -348,8 +349,11 @@ private:
 	base::flat_map<not_null<HistoryItem*>, crl::time> _repaintItems;
 	base::Timer _repaintTimer;
 	base::flat_set<not_null<HistoryItem*>> _pollItems;
-	base::flat_set<not_null<HistoryItem*>> _pollingItems;
-	mtpRequestId _pollRequestId = 0;
+	base::flat_map<
+		not_null<PeerData*>,
+		base::flat_set<not_null<HistoryItem*>>> _pollingItems;
+	base::flat_map<not_null<PeerData*>, mtpRequestId> _pollRequests;
+	base::Timer _pollTimer;
 
 	base::flat_map<not_null<HistoryItem*>, crl::time> _sendPaidItems;
 	base::flat_map<not_null<HistoryItem*>, mtpRequestId> _sendingPaid;
@@ -44,6 +44,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/business/data_shortcut_messages.h"
 #include "data/components/scheduled_messages.h"
 #include "data/components/sponsored_messages.h"
+#include "data/stickers/data_lottie_frames.h"
 #include "data/stickers/data_stickers.h"
 #include "data/notify/data_notify_settings.h"
 #include "data/data_bot_app.h"
@@ -77,6 +78,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_forum.h"
 #include "data/data_forum_topic.h"
 #include "data/data_todo_list.h"
+#include "data/data_text_storage.h"
 #include "base/platform/base_platform_info.h"
 #include "base/unixtime.h"
 #include "base/call_delayed.h"
@@ -87,6 +89,7 @@ namespace Data {
 namespace {
 
 constexpr auto kNextForUpgradeGiftTimeout = 5 * crl::time(1000);
+constexpr auto kMaxHeavyViewParts = 1024;
 
 using ViewElement = HistoryView::Element;
 
@@ -245,6 +248,8 @@ Session::Session(not_null<Main::Session*> session)
 , _mediaRotation(std::make_unique<MediaRotation>())
 , _histories(std::make_unique<Histories>(this))
 , _stickers(std::make_unique<Stickers>(this))
+, _lottieFrames(std::make_unique<LottieFrames>(this))
+, _textStorage(std::make_unique<TextStorage>())
 , _reactions(std::make_unique<Reactions>(this))
 , _emojiStatuses(std::make_unique<EmojiStatuses>(this))
 , _forumIcons(std::make_unique<ForumIcons>(this))
@@ -437,6 +442,7 @@ void Session::clear() {
 	cSetRecentInlineBots(RecentInlineBots());
 	cSetRecentStickers(RecentStickerPack());
 	HistoryView::Element::ClearGlobal();
+	HistoryView::ClearTextLayoutCache();
 	_contactsNoChatsList.clear();
 	_contactsList.clear();
 	_chatsList.clear();
@@ -2264,7 +2270,83 @@ Session::CreditsSubsRebuilderPtr Session::activeCreditsSubsRebuilder() const {
 }
 
 void Session::registerHeavyViewPart(not_null<ViewElement*> view) {
-	_heavyViewParts.emplace(view);
+	_heavyViewParts.emplace_or_assign(view, ++_heavyViewPartsCounter);
+	const auto limit = std::max(
+		_heavyViewPartsShrinkAfter,
+		kMaxHeavyViewParts);
+	if (int(_heavyViewParts.size()) > limit
+		&& !_heavyViewPartsShrinkScheduled) {
+		// Elements register their heavy parts while being painted,
+		// so don't unload other elements in the middle of a paint.
+		_heavyViewPartsShrinkScheduled = true;
+		crl::on_main(_session, [=] {
+			shrinkHeavyViewParts();
+		});
+	}
+}
+
+void Session::markHeavyViewPartUsed(not_null<ViewElement*> view) {
+	const auto i = _heavyViewParts.find(view);
+	if (i != end(_heavyViewParts)) {
+		i->second = ++_heavyViewPartsCounter;
+	}
+}
+
+bool Session::heavyViewPartVisible(not_null<ViewElement*> view) const {
+	const auto delegate = view->delegate();
+	const auto i = _heavyViewPartsVisible.find(delegate);
+	if (i == end(_heavyViewPartsVisible)) {
+		return false;
+	}
+	const auto &[from, till] = i->second;
+	return delegate->elementIntersectsRange(view, from, till);
+}
+
+void Session::shrinkHeavyViewParts() {
+	_heavyViewPartsShrinkScheduled = false;
+
+	// Heavy parts of all the open chats, sections and windows share
+	// one budget, the least recently used media parts are unloaded.
+	// Custom emoji in texts are cheap and don't count for the budget.
+	auto order = std::vector<std::pair<uint64, not_null<ViewElement*>>>();
+	order.reserve(_heavyViewParts.size());
+	for (const auto &[view, used] : _heavyViewParts) {
+		const auto media = view->media();
+		if (media && media->hasHeavyPart()) {
+			order.emplace_back(used, view);
+		}
+	}
+	const auto count = int(order.size()) - (kMaxHeavyViewParts * 3 / 4);
+	auto unloaded = 0;
+	auto photos = 0;
+	auto documents = 0;
+	if (int(order.size()) > kMaxHeavyViewParts) {
+		ranges::sort(order);
+		for (const auto &[used, view] : order) {
+			if (unloaded == count) {
+				break;
+			} else if (heavyViewPartVisible(view)) {
+				continue;
+			}
+			const auto media = view->media();
+			if (media->getPhoto()) {
+				++photos;
+			} else if (media->getDocument()) {
+				++documents;
+			}
+			view->unloadHeavyPart();
+			++unloaded;
+		}
+		DEBUG_LOG(("Heavy View Parts: unloaded %1 (%2 photos, "
+			"%3 documents), %4 resident."
+			).arg(unloaded
+			).arg(photos
+			).arg(documents
+			).arg(_heavyViewParts.size()));
+	}
+	// Don't rescan on each registration while only text parts are added.
+	_heavyViewPartsShrinkAfter = int(_heavyViewParts.size())
+		+ kMaxHeavyViewParts / 4;
 }
 
 void Session::unregisterHeavyViewPart(not_null<ViewElement*> view) {
@@ -2273,20 +2355,21 @@ void Session::unregisterHeavyViewPart(not_null<ViewElement*> view) {
 
 void Session::unloadHeavyViewParts(
 		not_null<HistoryView::ElementDelegate*> delegate) {
+	_heavyViewPartsVisible.remove(delegate);
 	if (_heavyViewParts.empty()) {
 		return;
 	}
 	const auto remove = ranges::count(
 		_heavyViewParts,
 		delegate,
-		[](not_null<ViewElement*> element) { return element->delegate(); });
+		[](const auto &pair) { return pair.first->delegate(); });
 	if (remove == _heavyViewParts.size()) {
-		for (const auto &view : base::take(_heavyViewParts)) {
+		for (const auto &[view, used] : base::take(_heavyViewParts)) {
 			view->unloadHeavyPart();
 		}
 	} else {
 		auto remove = std::vector<not_null<ViewElement*>>();
-		for (const auto &view : _heavyViewParts) {
+		for (const auto &[view, used] : _heavyViewParts) {
 			if (view->delegate() == delegate) {
 				remove.push_back(view);
 			}
@@ -2301,11 +2384,12 @@ void Session::unloadHeavyViewParts(
 		not_null<HistoryView::ElementDelegate*> delegate,
 		int from,
 		int till) {
+	setHeavyViewPartsVisible(delegate, from, till);
 	if (_heavyViewParts.empty()) {
 		return;
 	}
 	auto remove = std::vector<not_null<ViewElement*>>();
-	for (const auto &view : _heavyViewParts) {
+	for (const auto &[view, used] : _heavyViewParts) {
 		if (view->delegate() == delegate
 			&& !delegate->elementIntersectsRange(view, from, till)) {
 			remove.push_back(view);
@@ -2316,6 +2400,13 @@ void Session::unloadHeavyViewParts(
 	}
 }
 
+void Session::setHeavyViewPartsVisible(
+		not_null<HistoryView::ElementDelegate*> delegate,
+		int from,
+		int till) {
+	_heavyViewPartsVisible[delegate] = { from, till };
+}
+
 void Session::registerShownSpoiler(not_null<ViewElement*> view) {
 	_shownSpoilers.emplace(view);
 }
@@ -4686,7 +4777,7 @@ void Session::documentMessageRemoved(not_null<DocumentData*> document) {
 
 void Session::checkPlayingAnimations() {
 	auto check = base::flat_set<not_null<ViewElement*>>();
-	for (const auto &view : _heavyViewParts) {
+	for (const auto &[view, used] : _heavyViewParts) {
 		if (const auto media = view->media()) {
 			if (const auto document = media->getDocument()) {
 				if (document->isAnimation() || document->isVideoFile()) {
@@ -4937,14 +5028,22 @@ void Session::refreshChatListEntry(Dialogs::Key key) {
 	if (!history) {
 		return;
 	}
-	for (const auto &filter : _chatsFilters->list()) {
+
+	// Evaluate the history once, not once per each chat filter.
+	const auto &filters = _chatsFilters->list();
+	auto checked = ChatFilter::Flags();
+	for (const auto &filter : filters) {
+		checked |= filter.flags();
+	}
+	const auto rules = ChatFilter::RulesFor(history, checked);
+	for (const auto &filter : filters) {
 		const auto id = filter.id();
 		if (!id) {
 			continue;
 		}
 		const auto filterList = chatsFilters().chatsList(id);
 		auto event = ChatListEntryRefresh{ .key = key, .filterId = id };
-		if (filter.contains(history)) {
+		if (filter.matches(history, rules)) {
 			event.existenceChanged = !entry->inChatList(id);
 			if (event.existenceChanged) {
 				entry->addToChatList(id, filterList);
@@ -62,6 +62,8 @@ class Histories;
 class DocumentMedia;
 class PhotoMedia;
 class Stickers;
+class LottieFrames;
+class TextStorage;
 class GroupCall;
 class NotifySettings;
 class CustomEmojiManager;
@@ -172,6 +174,12 @@ public:
 	[[nodiscard]] Stickers &stickers() const {
 		return *_stickers;
 	}
+	[[nodiscard]] LottieFrames &lottieFrames() const {
+		return *_lottieFrames;
+	}
+	[[nodiscard]] TextStorage &textStorage() const {
+		return *_textStorage;
+	}
 	[[nodiscard]] Reactions &reactions() const {
 		return *_reactions;
 	}
@@ -407,6 +415,7 @@ public:
 		not_null<HistoryItem*> item);
 
 	void registerHeavyViewPart(not_null<ViewElement*> view);
+	void markHeavyViewPartUsed(not_null<ViewElement*> view);
 	void unregisterHeavyViewPart(not_null<ViewElement*> view);
 	void unloadHeavyViewParts(
 		not_null<HistoryView::ElementDelegate*> delegate);
@@ -414,6 +423,10 @@ public:
 		not_null<HistoryView::ElementDelegate*> delegate,
 		int from,
 		int till);
+	void setHeavyViewPartsVisible(
+		not_null<HistoryView::ElementDelegate*> delegate,
+		int from,
+		int till);
 
 	void registerShownSpoiler(not_null<ViewElement*> view);
 	void hideShownSpoilers();
@@ -908,6 +921,9 @@ private:
 	};
 
 	void suggestStartExport();
+	void shrinkHeavyViewParts();
+	[[nodiscard]] bool heavyViewPartVisible(
+		not_null<ViewElement*> view) const;
 
 	void setupMigrationViewer();
 	void setupChannelLeavingViewer();
@@ -1188,7 +1204,13 @@ private:
 
 	rpl::event_stream<> _pinnedDialogsOrderUpdated;
 
-	base::flat_set<not_null<ViewElement*>> _heavyViewParts;
+	base::flat_map<not_null<ViewElement*>, uint64> _heavyViewParts;
+	base::flat_map<
+		not_null<HistoryView::ElementDelegate*>,
+		std::pair<int, int>> _heavyViewPartsVisible;
+	uint64 _heavyViewPartsCounter = 0;
+	int _heavyViewPartsShrinkAfter = 0;
+	bool _heavyViewPartsShrinkScheduled = false;
 
 	base::flat_map<CallId, not_null<GroupCall*>> _groupCalls;
 	base::flat_map<CallId, std::weak_ptr<GroupCall>> _conferenceCalls;
@@ -1243,6 +1265,8 @@ private:
 	const std::unique_ptr<MediaRotation> _mediaRotation;
 	const std::unique_ptr<Histories> _histories;
 	const std::unique_ptr<Stickers> _stickers;
+	const std::unique_ptr<LottieFrames> _lottieFrames;
+	const std::unique_ptr<TextStorage> _textStorage;
 	const std::unique_ptr<Reactions> _reactions;
 	const std::unique_ptr<EmojiStatuses> _emojiStatuses;
 	const std::unique_ptr<ForumIcons> _forumIcons;
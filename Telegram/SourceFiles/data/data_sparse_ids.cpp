@@ -187,11 +187,38 @@ bool SparseIdsSliceBuilder::applyUpdate(
 	auto skippedAfter = (update.range.till == ServerMaxMsgId)
 		? 0
 		: std::optional<int> {};
+	if (!needMergeMessages) {
+		mergeSliceData(update.count, {}, skippedBefore, skippedAfter);
+		return true;
+	}
+	const auto &messages = *update.messages;
+	const auto around = _key
+		? ranges::lower_bound(messages, _key)
+		: messages.end();
+	const auto from = _key
+		? (around - std::min(int(around - messages.begin()), _limitBefore))
+		: messages.begin();
+	const auto till = _key
+		? (around + std::min(int(messages.end() - around), _limitAfter + 1))
+		: messages.end();
+	if ((from == messages.begin() && till == messages.end())
+		|| (from == till)) {
+		mergeSliceData(update.count, messages, skippedBefore, skippedAfter);
+		return true;
+	}
+
+	// Ids further than the limits from the key in the updated slice are
+	// further in the merged list as well and would be cut off right away,
+	// so don't copy the whole (possibly huge) slice for each update.
+	if (skippedBefore) {
+		*skippedBefore += int(from - messages.begin());
+	}
+	if (skippedAfter) {
+		*skippedAfter += int(messages.end() - till);
+	}
 	mergeSliceData(
 		update.count,
-		needMergeMessages
-			? *update.messages
-			: base::flat_set<MsgId> {},
+		base::flat_set<MsgId>{ from, till },
 		skippedBefore,
 		skippedAfter);
 	return true;
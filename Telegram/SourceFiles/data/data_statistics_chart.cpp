@@ -15,6 +15,54 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include <QtCore/QLocale>
 
 namespace Data {
+namespace {
+
+constexpr auto kMinDetailLevelsSize = 1024;
+constexpr auto kMinDetailLevelBuckets = 256;
+
+void BuildDetailLevels(StatisticalChart::Line &line) {
+	line.detailLevels.clear();
+	const auto &y = line.y;
+	const auto size = int(y.size());
+	if (size < kMinDetailLevelsSize) {
+		return;
+	}
+	// Level "-1" has each point in its own bucket.
+	auto previous = std::vector<int>(size * 2, -1);
+	for (auto i = 0; i != size; ++i) {
+		previous[2 * i] = i;
+	}
+	auto buckets = size;
+	while (buckets > kMinDetailLevelBuckets) {
+		const auto count = (buckets + 1) / 2;
+		auto level = std::vector<int>(count * 2, -1);
+		for (auto bucket = 0; bucket != count; ++bucket) {
+			auto min = -1;
+			auto max = -1;
+			const auto from = bucket * 4;
+			const auto till = std::min(from + 4, buckets * 2);
+			for (auto j = from; j != till; ++j) {
+				const auto index = previous[j];
+				if (index < 0 || y[index] < 0) {
+					continue;
+				}
+				if (min < 0 || y[index] < y[min]) {
+					min = index;
+				}
+				if (max < 0 || y[index] > y[max]) {
+					max = index;
+				}
+			}
+			level[bucket * 2] = std::min(min, max);
+			level[bucket * 2 + 1] = std::max(min, max);
+		}
+		line.detailLevels.push_back(level);
+		previous = std::move(level);
+		buckets = count;
+	}
+}
+
+} // namespace
 
 void StatisticalChart::measure() {
 	if (x.empty()) {
@@ -42,6 +90,7 @@ void StatisticalChart::measure() {
 			minValue = line.minValue;
 		}
 		line.segmentTree = Statistic::SegmentTree(line.y);
+		BuildDetailLevels(line);
 	}
 
 	daysLookup.clear();
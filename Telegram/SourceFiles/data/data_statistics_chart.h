@@ -39,6 +39,12 @@ struct StatisticalChart {
 		std::vector<Statistic::ChartValue> y;
 
 		Statistic::SegmentTree segmentTree;
+
+		// Level k keeps min and max value indices (ascending, -1 if none)
+		// for each bucket of (2 << k) points, so dense charts are painted
+		// with about one bucket per pixel column.
+		std::vector<std::vector<int>> detailLevels;
+
 		int id = 0;
 		QString idString;
 		QString name;
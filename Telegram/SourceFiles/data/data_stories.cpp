@@ -2267,6 +2267,10 @@ void Stories::setPreloadingInViewer(std::vector<FullStoryId> ids) {
 	}
 }
 
+bool Stories::preloaded(FullStoryId id) const {
+	return _preloaded.contains(id);
+}
+
 std::optional<Stories::PeerSourceState> Stories::peerSourceState(
 		not_null<PeerData*> peer,
 		StoryId storyMaxId) {
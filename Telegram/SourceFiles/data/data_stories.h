@@ -254,6 +254,7 @@ public:
 	void incrementPreloadingHiddenSources();
 	void decrementPreloadingHiddenSources();
 	void setPreloadingInViewer(std::vector<FullStoryId> ids);
+	[[nodiscard]] bool preloaded(FullStoryId id) const;
 
 	struct PeerSourceState {
 		StoryId maxId = 0;
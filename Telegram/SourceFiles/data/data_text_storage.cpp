@@ -0,0 +1,104 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "data/data_text_storage.h"
+
+#include <xxhash.h>
+
+namespace Data {
+namespace {
+
+constexpr auto kMinSharedLength = 64;
+constexpr auto kMinCollectThreshold = 1024;
+
+[[nodiscard]] uint64 HashString(const QString &value, uint64 seed) {
+	return XXH64(value.constData(), value.size() * sizeof(QChar), seed);
+}
+
+[[nodiscard]] uint64 ComputeHash(const TextWithEntities &text) {
+	auto result = HashString(text.text, 0);
+	for (const auto &entity : text.entities) {
+		const int32 values[] = {
+			int32(entity.type()),
+			int32(entity.offset()),
+			int32(entity.length()),
+		};
+		result = XXH64(values, sizeof(values), result);
+		result = HashString(entity.data(), result);
+	}
+	return result;
+}
+
+[[nodiscard]] int64 ComputeSize(const TextWithEntities &text) {
+	auto result = int64(text.text.size() * sizeof(QChar));
+	for (const auto &entity : text.entities) {
+		result += sizeof(EntityInText)
+			+ entity.data().size() * sizeof(QChar);
+	}
+	return result;
+}
+
+} // namespace
+
+TextStorage::TextStorage()
+: _collectThreshold(kMinCollectThreshold) {
+}
+
+TextStorage::~TextStorage() {
+	log();
+}
+
+TextWithEntities TextStorage::share(TextWithEntities &&text) {
+	if (text.text.size() < kMinSharedLength) {
+		return std::move(text);
+	}
+	const auto hash = ComputeHash(text);
+	const auto i = _texts.find(hash);
+	if (i == end(_texts)) {
+		_texts.emplace(hash, text);
+		if (int(_texts.size()) >= _collectThreshold) {
+			collect();
+		}
+		return std::move(text);
+	} else if (i->second != text) {
+		++_collisions;
+		return std::move(text);
+	}
+	++_sharedCount;
+	_sharedBytes += ComputeSize(text);
+	return i->second;
+}
+
+void TextStorage::collect() {
+	// Drop texts no item references any more and make the next
+	// collection wait for as many new texts, so it stays amortized.
+	const auto detached = [](const TextWithEntities &text) {
+		return text.text.isDetached()
+			&& (text.entities.isEmpty() || text.entities.isDetached());
+	};
+	for (auto i = begin(_texts); i != end(_texts);) {
+		if (detached(i->second)) {
+			i = _texts.erase(i);
+		} else {
+			++i;
+		}
+	}
+	_collectThreshold = std::max(
+		kMinCollectThreshold,
+		int(_texts.size()) * 2);
+}
+
+void TextStorage::log() const {
+	DEBUG_LOG(("Text Storage: %1 texts, %2 shared in %3 bytes, "
+		"%4 collisions."
+		).arg(_texts.size()
+		).arg(_sharedCount
+		).arg(_sharedBytes
+		).arg(_collisions));
+}
+
+} // namespace Data
@@ -0,0 +1,36 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+namespace Data {
+
+// Interns message texts, so that equal texts of different items (like
+// a channel post forwarded to many chats) share one implicitly shared
+// string and entities list. Texts held only by the storage are dropped
+// from time to time.
+class TextStorage final {
+public:
+	TextStorage();
+	~TextStorage();
+
+	[[nodiscard]] TextWithEntities share(TextWithEntities &&text);
+
+private:
+	void collect();
+	void log() const;
+
+	std::unordered_map<uint64, TextWithEntities> _texts;
+	int _collectThreshold = 0;
+
+	int64 _sharedBytes = 0;
+	int _sharedCount = 0;
+	int _collisions = 0;
+
+};
+
+} // namespace Data
@@ -0,0 +1,70 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "data/stickers/data_lottie_frames.h"
+
+#include "data/data_session.h"
+#include "storage/cache/storage_cache_database.h"
+
+#include <QtCore/QMutex>
+
+namespace Data {
+
+using Handler = FnMut<void(QByteArray &&cached)>;
+
+struct LottieFrames::Loading {
+	QMutex mutex;
+	base::flat_map<Storage::Cache::Key, std::vector<Handler>> handlers;
+	int diskReads = 0;
+	int joinedReads = 0;
+};
+
+LottieFrames::LottieFrames(not_null<Session*> owner)
+: _owner(owner)
+, _loading(std::make_shared<Loading>()) {
+}
+
+LottieFrames::~LottieFrames() {
+	QMutexLocker lock(&_loading->mutex);
+	DEBUG_LOG(("Lottie Frames: %1 disk reads, %2 joined reads."
+		).arg(_loading->diskReads
+		).arg(_loading->joinedReads));
+}
+
+void LottieFrames::get(Storage::Cache::Key key, Handler done) {
+	{
+		QMutexLocker lock(&_loading->mutex);
+		auto &handlers = _loading->handlers[key];
+		handlers.push_back(std::move(done));
+		if (handlers.size() > 1) {
+			++_loading->joinedReads;
+			return;
+		}
+		++_loading->diskReads;
+	}
+
+	// The handlers are called right on the database thread,
+	// the same way cacheBigFile() calls them without joining.
+	const auto loading = _loading;
+	_owner->cacheBigFile().get(key, [=](QByteArray &&cached) {
+		auto handlers = [&] {
+			QMutexLocker lock(&loading->mutex);
+			return loading->handlers.take(key).value_or(
+				std::vector<Handler>());
+		}();
+		if (handlers.empty()) {
+			return;
+		}
+		const auto last = int(handlers.size()) - 1;
+		for (auto i = 0; i != last; ++i) {
+			handlers[i](base::duplicate(cached));
+		}
+		handlers[last](std::move(cached));
+	});
+}
+
+} // namespace Data
@@ -0,0 +1,37 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include "storage/cache/storage_cache_types.h"
+
+namespace Data {
+
+class Session;
+
+// Joins reads of pre-rendered Lottie frames from cacheBigFile() with the
+// same (document, size, replacements) key, so that players for one
+// sticker in the chat, the stickers panel and reactions that start
+// together wait for a single database read.
+class LottieFrames final {
+public:
+	explicit LottieFrames(not_null<Session*> owner);
+	~LottieFrames();
+
+	void get(
+		Storage::Cache::Key key,
+		FnMut<void(QByteArray &&cached)> done);
+
+private:
+	struct Loading;
+
+	const not_null<Session*> _owner;
+	const std::shared_ptr<Loading> _loading;
+
+};
+
+} // namespace Data
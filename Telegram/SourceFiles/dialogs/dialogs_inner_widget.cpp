@@ -18,6 +18,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "dialogs/dialogs_search_tags.h"
 #include "dialogs/dialogs_quick_action.h"
 #include "history/view/history_view_context_menu.h"
+#include "history/view/history_view_send_action.h"
 #include "history/view/history_view_subsection_tabs.h"
 #include "history/history.h"
 #include "history/history_item.h"
@@ -291,6 +292,7 @@ InnerWidget::InnerWidget(
 , _controller(controller)
 , _shownList(controller->session().data().chatsList()->indexed())
 , _st(&st::defaultDialogRow)
+, _rowPaintCache([=] { update(); })
 , _pinnedShiftAnimation([=](crl::time now) {
 	return pinnedShiftAnimationCallback(now);
 })
@@ -303,6 +305,7 @@ InnerWidget::InnerWidget(
 	style::PaletteChanged(
 	) | rpl::start_with_next([=] {
 		_topicJumpCache = nullptr;
+		_rowPaintCache.clear();
 		_chatsFilterTags.clear();
 		_rightButtons.clear();
 		_pressedRightButtonData = nullptr;
@@ -315,6 +318,7 @@ InnerWidget::InnerWidget(
 
 	session().downloaderTaskFinished(
 	) | rpl::start_with_next([=] {
+		_rowPaintCache.clear();
 		update();
 	}, lifetime());
 
@@ -846,6 +850,7 @@ void InnerWidget::paintEvent(QPaintEvent *e) {
 	auto fullWidth = width();
 	const auto r = e->rect();
 	auto dialogsClip = r;
+	_rowPaintCache.paintStarted(r);
 	const auto ms = crl::now();
 	const auto childListShown = _childListShown.current();
 	auto context = Ui::PaintContext{
@@ -979,7 +984,45 @@ void InnerWidget::paintEvent(QPaintEvent *e) {
 		context.topicJumpSelected = selected
 			&& _selectedTopicJump
 			&& (!_pressed || _pressedTopicJump);
-		Ui::RowPainter::Paint(p, row, validateVideoUserpic(row), context);
+		const auto videoUserpic = validateVideoUserpic(row);
+		const auto thread = row->thread();
+		const auto history = row->history();
+		const auto sendAction = thread
+			? thread->sendActionPainter()
+			: nullptr;
+		if (videoUserpic
+			|| (_state != WidgetState::Default)
+			|| !history
+			|| row->topic()
+			|| context.quickActionContext
+			|| (context.topicsExpanded > 0.)
+			|| row->animating()
+			|| history->peer->emojiStatusId()
+			|| history->lastItemDialogsView().animated()
+			|| (sendAction && sendAction->animating())) {
+			Ui::RowPainter::Paint(p, row, videoUserpic, context);
+		} else {
+			auto tagsHash = uint64();
+			if (context.chatsFilterTags) {
+				for (const auto tag : *context.chatsFilterTags) {
+					tagsHash = (tagsHash * 31) + uint64(uintptr_t(tag));
+				}
+			}
+			_rowPaintCache.paint(p, row->key(), {
+				.st = context.st,
+				.tagsHash = tagsHash,
+				.filter = context.filter,
+				.width = context.width,
+				.height = row->height(),
+				.active = context.active,
+				.selected = context.selected,
+				.topicJumpSelected = context.topicJumpSelected,
+				.narrow = context.narrow,
+				.paused = context.paused,
+			}, [&](Painter &q) {
+				Ui::RowPainter::Paint(q, row, nullptr, context);
+			});
+		}
 		if (context.quickActionContext) {
 			context.quickActionContext = nullptr;
 		}
@@ -2843,6 +2886,7 @@ int InnerWidget::defaultRowTop(not_null<Row*> row) const {
 void InnerWidget::repaintDialogRow(
 		FilterId filterId,
 		not_null<Row*> row) {
+	_rowPaintCache.invalidate(row->key());
 	if (_state == WidgetState::Default) {
 		if (_filterId == filterId) {
 			if (const auto folder = row->folder()) {
@@ -2915,6 +2959,7 @@ void InnerWidget::updateDialogRow(
 			}
 		}
 	}
+	_rowPaintCache.invalidate(row.key);
 
 	const auto updateRow = [&](int rowTop, int rowHeight) {
 		if (!updateRect.isEmpty()) {
@@ -3809,6 +3854,19 @@ rpl::producer<> InnerWidget::refreshHashtagsRequests() const {
 void InnerWidget::visibleTopBottomUpdated(
 		int visibleTop,
 		int visibleBottom) {
+	if (_visibleTop != visibleTop) {
+		const auto exposedTop = (visibleTop > _visibleTop)
+			? std::max(_visibleBottom, visibleTop)
+			: visibleTop;
+		const auto exposedBottom = (visibleTop > _visibleTop)
+			? visibleBottom
+			: std::min(visibleBottom, _visibleTop);
+		_rowPaintCache.scrolled(QRect(
+			0,
+			exposedTop,
+			width(),
+			std::max(exposedBottom - exposedTop, 0)));
+	}
 	_visibleTop = visibleTop;
 	_visibleBottom = visibleBottom;
 	preloadRowsData();
@@ -62,19 +62,25 @@ not_null<Row*> List::addByName(Key key) {
 void List::adjustByName(not_null<Row*> row) {
 	Expects(row->index() >= 0 && row->index() < _rows.size());
 
+	// Rows except this one are sorted, so look for the place by bisection.
 	const auto &key = row->entry()->chatListNameSortKey();
 	const auto index = row->index();
 	const auto i = _rows.begin() + index;
-	const auto before = std::find_if(i + 1, _rows.end(), [&](Row *row) {
-		return row->entry()->chatListNameSortKey().compare(key) >= 0;
-	});
+	const auto compare = [&](not_null<Row*> row) {
+		return row->entry()->chatListNameSortKey().compare(key);
+	};
+	const auto before = (i + 1 == _rows.end() || compare(*(i + 1)) >= 0)
+		? (i + 1)
+		: std::partition_point(i + 1, _rows.end(), [&](not_null<Row*> row) {
+			return compare(row) < 0;
+		});
 	if (before != i + 1) {
 		rotate(i, i + 1, before);
-	} else if (i != _rows.begin()) {
-		const auto from = std::make_reverse_iterator(i);
-		const auto after = std::find_if(from, _rows.rend(), [&](Row *row) {
-			return row->entry()->chatListNameSortKey().compare(key) <= 0;
-		}).base();
+	} else if (i != _rows.begin() && compare(*(i - 1)) > 0) {
+		const auto after = std::partition_point(
+			_rows.begin(),
+			i,
+			[&](not_null<Row*> row) { return compare(row) <= 0; });
 		if (after != i) {
 			rotate(after, i, i + 1);
 		}
@@ -84,19 +90,25 @@ void List::adjustByName(not_null<Row*> row) {
 void List::adjustByDate(not_null<Row*> row) {
 	Expects(_sortMode == SortMode::Date);
 
+	// Rows except this one are sorted, so look for the place by bisection.
 	const auto key = row->sortKey(_filterId);
 	const auto index = row->index();
 	const auto i = _rows.begin() + index;
-	const auto before = std::find_if(i + 1, _rows.end(), [&](Row *row) {
-		return (row->sortKey(_filterId) <= key);
-	});
+	const auto sortKey = [&](not_null<Row*> row) {
+		return row->sortKey(_filterId);
+	};
+	const auto before = (i + 1 == _rows.end() || sortKey(*(i + 1)) <= key)
+		? (i + 1)
+		: std::partition_point(i + 1, _rows.end(), [&](not_null<Row*> row) {
+			return (sortKey(row) > key);
+		});
 	if (before != i + 1) {
 		rotate(i, i + 1, before);
-	} else {
-		const auto from = std::make_reverse_iterator(i);
-		const auto after = std::find_if(from, _rows.rend(), [&](Row *row) {
-			return (row->sortKey(_filterId) >= key);
-		}).base();
+	} else if (i != _rows.begin() && sortKey(*(i - 1)) < key) {
+		const auto after = std::partition_point(
+			_rows.begin(),
+			i,
+			[&](not_null<Row*> row) { return (sortKey(row) >= key); });
 		if (after != i) {
 			rotate(after, i, i + 1);
 		}
@@ -730,6 +730,14 @@ bool Row::topicJumpRipple() const {
 	return _topicJumpRipple != 0;
 }
 
+bool Row::animating() const {
+	return hasRipple()
+		|| _topicJumpRipple
+		|| _hasVideoCall
+		|| (_cornerBadgeUserpic
+			&& !_cornerBadgeUserpic->layersManager.isFinished());
+}
+
 FakeRow::FakeRow(
 	Key searchInChat,
 	not_null<HistoryItem*> item,
@@ -72,6 +72,9 @@ public:
 	[[nodiscard]] Ui::PeerUserpicView &userpicView() const {
 		return _userpic;
 	}
+	[[nodiscard]] bool hasRipple() const {
+		return _ripple != nullptr;
+	}
 	[[nodiscard]] Ui::PeerUserpicView &userpicCornerView() const {
 		return _userpicCorner;
 	}
@@ -126,6 +129,7 @@ public:
 		Fn<void()> updateCallback);
 	void clearTopicJumpRipple();
 	[[nodiscard]] bool topicJumpRipple() const;
+	[[nodiscard]] bool animating() const;
 
 	[[nodiscard]] Key key() const {
 		return _id;
@@ -0,0 +1,129 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "dialogs/dialogs_row_paint_cache.h"
+
+#include "ui/painter.h"
+
+namespace Dialogs {
+namespace {
+
+constexpr auto kSettleTimeout = crl::time(300);
+constexpr auto kMaxCachedRows = 48;
+
+} // namespace
+
+RowPaintCache::RowPaintCache(Fn<void()> settled)
+: _settled(std::move(settled))
+, _settleTimer([=] { settle(); }) {
+}
+
+RowPaintCache::~RowPaintCache() = default;
+
+void RowPaintCache::scrolled(QRect exposed) {
+	_settleTimer.callOnce(kSettleTimeout);
+	_exposed = _exposed.united(exposed);
+}
+
+void RowPaintCache::paintStarted(QRect clip) {
+	// A paint not limited to the strips exposed by scrolling comes from
+	// an update() of something that could have changed in any row.
+	_scrollPaint = enabled() && _exposed.contains(clip);
+	if (!_scrollPaint) {
+		clear();
+	}
+	_exposed = QRect();
+}
+
+bool RowPaintCache::enabled() const {
+	return _settleTimer.isActive();
+}
+
+void RowPaintCache::paint(
+		Painter &p,
+		Key key,
+		const State &state,
+		Fn<void(Painter&)> paint) {
+	if (!_scrollPaint) {
+		paint(p);
+		return;
+	}
+	auto i = _rows.find(key);
+	if (i != end(_rows) && i->second.state == state) {
+		if (i->second.image.isNull()) {
+			// The row is back in view, keep a copy from now on.
+			++_misses;
+			const auto ratio = style::DevicePixelRatio();
+			const auto size = QSize(state.width, state.height) * ratio;
+			auto &image = i->second.image;
+			image = (_spare.size() == size)
+				? base::take(_spare)
+				: QImage(size, QImage::Format_ARGB32_Premultiplied);
+			image.setDevicePixelRatio(ratio);
+			image.fill(Qt::transparent);
+			{
+				auto q = Painter(&image);
+				q.setInactive(p.inactive());
+				paint(q);
+			}
+		} else {
+			++_hits;
+		}
+		i->second.lastUsed = ++_counter;
+		p.drawImage(0, 0, i->second.image);
+		return;
+	}
+
+	// The first time a row is seen it is painted live, so that rows
+	// scrolled past only once don't pay for a copy.
+	++_misses;
+	if (i == end(_rows)) {
+		if (_rows.size() >= kMaxCachedRows) {
+			shrink();
+		}
+		i = _rows.emplace(key, Cached()).first;
+	} else if (!i->second.image.isNull()) {
+		_spare = base::take(i->second.image);
+	}
+	i->second.state = state;
+	i->second.lastUsed = ++_counter;
+	paint(p);
+}
+
+void RowPaintCache::invalidate(Key key) {
+	_rows.remove(key);
+}
+
+void RowPaintCache::clear() {
+	_rows.clear();
+	_spare = QImage();
+}
+
+void RowPaintCache::settle() {
+	DEBUG_LOG(("Dialogs Row Cache: %1 hits, %2 misses while scrolling."
+		).arg(_hits
+		).arg(_misses));
+	_hits = _misses = 0;
+	_exposed = QRect();
+	clear();
+	if (_settled) {
+		_settled();
+	}
+}
+
+void RowPaintCache::shrink() {
+	const auto i = ranges::min_element(_rows, ranges::less(), [](
+			const auto &pair) {
+		return pair.second.lastUsed;
+	});
+	if (!i->second.image.isNull()) {
+		_spare = base::take(i->second.image);
+	}
+	_rows.erase(i);
+}
+
+} // namespace Dialogs
@@ -0,0 +1,84 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include "base/timer.h"
+#include "dialogs/dialogs_key.h"
+
+class Painter;
+
+namespace style {
+struct DialogRow;
+} // namespace style
+
+namespace Dialogs {
+
+// Raster copies of chat list rows, used only while the list is scrolled,
+// so that rows coming into view again are blitted instead of re-laid out.
+// Copies are used only in paints of the strips exposed by scrolling, any
+// other repaint drops them all. Rows with animated content are painted
+// live by the caller, and all copies are dropped once scrolling settles.
+class RowPaintCache final {
+public:
+	explicit RowPaintCache(Fn<void()> settled);
+	~RowPaintCache();
+
+	struct State {
+		const style::DialogRow *st = nullptr;
+		uint64 tagsHash = 0;
+		FilterId filter = 0;
+		int width = 0;
+		int height = 0;
+		bool active = false;
+		bool selected = false;
+		bool topicJumpSelected = false;
+		bool narrow = false;
+		bool paused = false;
+
+		friend inline bool operator==(
+			const State &,
+			const State &) = default;
+	};
+
+	void scrolled(QRect exposed);
+	void paintStarted(QRect clip);
+	[[nodiscard]] bool enabled() const;
+
+	void paint(
+		Painter &p,
+		Key key,
+		const State &state,
+		Fn<void(Painter&)> paint);
+
+	void invalidate(Key key);
+	void clear();
+
+private:
+	struct Cached {
+		State state;
+		QImage image;
+		uint64 lastUsed = 0;
+	};
+
+	void settle();
+	void shrink();
+
+	const Fn<void()> _settled;
+	base::flat_map<Key, Cached> _rows;
+	base::Timer _settleTimer;
+	QRect _exposed;
+	QImage _spare;
+	uint64 _counter = 0;
+	bool _scrollPaint = false;
+
+	int _hits = 0;
+	int _misses = 0;
+
+};
+
+} // namespace Dialogs
@@ -139,6 +139,14 @@ bool MessageView::dependsOn(not_null<const HistoryItem*> item) const {
 	return (_textCachedFor == item.get());
 }
 
+bool MessageView::animated() const {
+	return _topics
+		|| _spoiler
+		|| _loadingContext
+		|| _senderCache.hasPersistentAnimation()
+		|| _textCache.hasPersistentAnimation();
+}
+
 bool MessageView::prepared(
 		not_null<const HistoryItem*> item,
 		Data::Forum *forum,
@@ -54,6 +54,7 @@ public:
 
 	void itemInvalidated(not_null<const HistoryItem*> item);
 	[[nodiscard]] bool dependsOn(not_null<const HistoryItem*> item) const;
+	[[nodiscard]] bool animated() const;
 
 	[[nodiscard]] bool prepared(
 		not_null<const HistoryItem*> item,
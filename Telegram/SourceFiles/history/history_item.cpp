@@ -64,6 +64,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_poll.h" // PollData::publicVotes.
 #include "data/data_todo_list.h"
 #include "data/data_stories.h"
+#include "data/data_text_storage.h"
 #include "data/data_web_page.h"
 #include "chat_helpers/stickers_gift_box_pack.h"
 #include "payments/payments_checkout_process.h" // CheckoutProcess::Start.
@@ -3784,7 +3785,7 @@ void HistoryItem::setTextValue(TextWithEntities text, bool force) {
 		history()->owner().registerHighlightProcess(processId, this);
 	}
 	const auto had = !_text.empty();
-	_text = std::move(text);
+	_text = history()->owner().textStorage().share(std::move(text));
 	RemoveComponents(HistoryMessageTranslation::Bit());
 	if (had || force) {
 		history()->owner().requestItemTextRefresh(this);
@@ -197,6 +197,12 @@ namespace {
 constexpr auto kMessagesPerPageFirst = 30;
 constexpr auto kMessagesPerPage = 50;
 constexpr auto kPreloadHeightsCount = 3; // when 3 screens to scroll left make a preload request
+constexpr auto kMessagesPerPageFast = 100;
+constexpr auto kMaxPreloadHeightsCount = 12;
+constexpr auto kDefaultPreloadLatency = crl::time(500);
+constexpr auto kPreloadVelocityTimeout = crl::time(300);
+constexpr auto kMaxPreloadVelocity = 20.; // Pixels per ms.
+constexpr auto kSupportPreloadLookahead = 3;
 constexpr auto kScrollToVoiceAfterScrolledMs = 1000;
 constexpr auto kSkipRepaintWhileScrollMs = 100;
 constexpr auto kShowMembersDropdownTimeoutMs = 300;
@@ -1050,6 +1056,8 @@ HistoryWidget::HistoryWidget(
 		[=] { return _history; });
 
 	if (session().supportMode()) {
+		_supportPreloader = std::make_unique<Support::Preloader>(
+			&session());
 		session().data().chatListEntryRefreshes(
 		) | rpl::start_with_next([=] {
 			crl::on_main(this, [=] { checkSupportPreload(true); });
@@ -2909,7 +2917,6 @@ void HistoryWidget::setHistory(History *history) {
 	if (_history) {
 		unregisterDraftSources();
 		clearAllLoadRequests();
-		clearSupportPreloadRequest();
 		_historySponsoredPreloading.destroy();
 		const auto wasHistory = base::take(_history);
 		const auto wasMigrated = base::take(_migrated);
@@ -2923,6 +2930,9 @@ void HistoryWidget::setHistory(History *history) {
 	if (history) {
 		_history = history;
 		_migrated = _history ? _history->migrateFrom() : nullptr;
+		if (_supportPreloader) {
+			_supportPreloader->opened(history);
+		}
 		registerDraftSource();
 		if (_history) {
 			setupPreview();
@@ -3067,16 +3077,6 @@ void HistoryWidget::clearDelayedShowAtRequest() {
 	}
 }
 
-void HistoryWidget::clearSupportPreloadRequest() {
-	Expects(_history != nullptr);
-
-	if (_supportPreloadRequest) {
-		auto &histories = _history->owner().histories();
-		histories.cancelRequest(_supportPreloadRequest);
-		_supportPreloadRequest = 0;
-	}
-}
-
 void HistoryWidget::clearAllLoadRequests() {
 	Expects(_history != nullptr);
 
@@ -3964,10 +3964,12 @@ void HistoryWidget::messagesReceived(
 	}
 
 	if (_preloadRequest == requestId) {
+		preloadReceived(_preloadSent);
 		addMessagesToFront(peer, *histList);
 		_preloadRequest = 0;
 		preloadHistoryIfNeeded();
 	} else if (_preloadDownRequest == requestId) {
+		preloadReceived(_preloadDownSent);
 		addMessagesToBack(peer, *histList);
 		_preloadDownRequest = 0;
 		preloadHistoryIfNeeded();
@@ -4167,7 +4169,7 @@ void HistoryWidget::loadMessages() {
 	const auto offsetId = from->minMsgId();
 	const auto addOffset = 0;
 	const auto loadCount = offsetId
-		? kMessagesPerPage
+		? preloadPageSize(true)
 		: kMessagesPerPageFirst;
 	const auto offsetDate = 0;
 	const auto maxId = 0;
@@ -4183,6 +4185,7 @@ void HistoryWidget::loadMessages() {
 	const auto history = from;
 	const auto type = Data::Histories::RequestType::History;
 	auto &histories = history->owner().histories();
+	_preloadSent = crl::now();
 	_preloadRequest = histories.sendRequest(history, type, [=](
 			Fn<void()> finish) {
 		return history->session().api().request(MTPmessages_GetHistory(
@@ -4225,7 +4228,7 @@ void HistoryWidget::loadMessagesDown() {
 		return;
 	}
 
-	const auto loadCount = kMessagesPerPage;
+	const auto loadCount = preloadPageSize(false);
 	auto addOffset = -loadCount;
 	auto offsetId = from->maxMsgId();
 	if (!offsetId) {
@@ -4249,6 +4252,7 @@ void HistoryWidget::loadMessagesDown() {
 	const auto history = from;
 	const auto type = Data::Histories::RequestType::History;
 	auto &histories = history->owner().histories();
+	_preloadDownSent = crl::now();
 	_preloadDownRequest = histories.sendRequest(history, type, [=](
 			Fn<void()> finish) {
 		return history->session().api().request(MTPmessages_GetHistory(
@@ -4430,11 +4434,11 @@ void HistoryWidget::preloadHistoryByScroll() {
 
 	auto scrollTop = _scroll->scrollTop();
 	auto scrollTopMax = _scroll->scrollTopMax();
-	auto scrollHeight = _scroll->height();
-	if (scrollTop + kPreloadHeightsCount * scrollHeight >= scrollTopMax) {
+	updatePreloadVelocity(scrollTop, scrollTopMax);
+	if (scrollTop + preloadDistance(false) >= scrollTopMax) {
 		loadMessagesDown();
 	}
-	if (scrollTop <= kPreloadHeightsCount * scrollHeight) {
+	if (scrollTop <= preloadDistance(true)) {
 		loadMessages();
 	}
 	if (session().supportMode()) {
@@ -4442,34 +4446,86 @@ void HistoryWidget::preloadHistoryByScroll() {
 	}
 }
 
+void HistoryWidget::updatePreloadVelocity(int scrollTop, int scrollTopMax) {
+	const auto now = crl::now();
+	const auto elapsed = now - _preloadScrolled;
+	if (!_preloadScrolled || elapsed > kPreloadVelocityTimeout) {
+		_preloadVelocity = 0.;
+	} else if (elapsed > 0 && scrollTopMax == _preloadScrollTopMax) {
+		// Loaded messages shift the scroll position without any scrolling,
+		// so only the samples with the same content height are counted.
+		const auto instant = std::clamp(
+			(scrollTop - _preloadScrollTop) / float64(elapsed),
+			-kMaxPreloadVelocity,
+			kMaxPreloadVelocity);
+		_preloadVelocity = (_preloadVelocity + instant) / 2.;
+	}
+	_preloadScrolled = now;
+	_preloadScrollTop = scrollTop;
+	_preloadScrollTopMax = scrollTopMax;
+}
+
+int HistoryWidget::preloadDistance(bool up) const {
+	// Keep enough loaded to cover the distance scrolled while
+	// the next page is being requested, twice to be safe.
+	const auto height = _scroll->height();
+	const auto velocity = up ? -_preloadVelocity : _preloadVelocity;
+	const auto latency = _preloadLatency
+		? _preloadLatency
+		: kDefaultPreloadLatency;
+	const auto ahead = (velocity > 0.) ? int(velocity * latency * 2) : 0;
+	return std::clamp(
+		ahead,
+		kPreloadHeightsCount * height,
+		kMaxPreloadHeightsCount * height);
+}
+
+int HistoryWidget::preloadPageSize(bool up) const {
+	const auto fast = (preloadDistance(up)
+		> kPreloadHeightsCount * _scroll->height());
+	return fast ? kMessagesPerPageFast : kMessagesPerPage;
+}
+
+void HistoryWidget::preloadReceived(crl::time sent) {
+	const auto latency = crl::now() - sent;
+	_preloadLatency = _preloadLatency
+		? ((_preloadLatency + latency) / 2)
+		: latency;
+}
+
 void HistoryWidget::checkSupportPreload(bool force) {
 	if (!_history
+		|| !_supportPreloader
 		|| _firstLoadRequest
 		|| _preloadRequest
 		|| _preloadDownRequest
-		|| (_supportPreloadRequest && !force)
+		|| (_supportPreloader->busy() && !force)
 		|| controller()->activeChatEntryCurrent().key.history() != _history) {
 		return;
 	}
 
 	const auto setting = session().settings().supportSwitch();
 	const auto command = Support::GetSwitchCommand(setting);
-	const auto descriptor = !command
-		? Dialogs::RowDescriptor()
-		: (*command == Shortcuts::Command::ChatNext)
-		? controller()->resolveChatNext()
-		: controller()->resolveChatPrevious();
-	auto history = descriptor.key.history();
-	if (!history || _supportPreloadHistory == history) {
-		return;
-	}
-	clearSupportPreloadRequest();
-	_supportPreloadHistory = history;
-	_supportPreloadRequest = Support::SendPreloadRequest(history, [=] {
-		_supportPreloadRequest = 0;
-		_supportPreloadHistory = nullptr;
-		crl::on_main(this, [=] { checkSupportPreload(); });
-	});
+	if (!command) {
+		_supportPreloader->cancel();
+		return;
+	}
+	const auto next = (*command == Shortcuts::Command::ChatNext);
+	auto upcoming = std::vector<not_null<History*>>();
+	auto descriptor = Dialogs::RowDescriptor();
+	while (upcoming.size() < kSupportPreloadLookahead) {
+		descriptor = next
+			? controller()->resolveChatNext(descriptor)
+			: controller()->resolveChatPrevious(descriptor);
+		const auto history = descriptor.key.history();
+		if (!history
+			|| history == _history
+			|| ranges::contains(upcoming, not_null(history))) {
+			break;
+		}
+		upcoming.push_back(history);
+	}
+	_supportPreloader->preload(upcoming);
 }
 
 void HistoryWidget::checkReplyReturns() {
@@ -54,6 +54,7 @@ struct ResultSelected;
 
 namespace Support {
 class Autocomplete;
+class Preloader;
 struct Contact;
 } // namespace Support
 
@@ -257,7 +258,6 @@ public:
 		Data::ReportInput reportInput,
 		Fn<void(std::vector<MsgId>)> callback);
 	void clearAllLoadRequests();
-	void clearSupportPreloadRequest();
 	void clearDelayedShowAtRequest();
 	void clearDelayedShowAt();
 
@@ -664,6 +664,10 @@ private:
 	int countInitialScrollTop();
 	int countAutomaticScrollTop();
 	void preloadHistoryByScroll();
+	void updatePreloadVelocity(int scrollTop, int scrollTopMax);
+	[[nodiscard]] int preloadDistance(bool up) const;
+	[[nodiscard]] int preloadPageSize(bool up) const;
+	void preloadReceived(crl::time sent);
 	void checkReplyReturns();
 	void scrollToAnimationCallback(FullMsgId attachToId, int relativeTo);
 
@@ -777,13 +781,19 @@ private:
 	int _firstLoadRequest = 0; // Not real mtpRequestId.
 	int _preloadRequest = 0; // Not real mtpRequestId.
 	int _preloadDownRequest = 0; // Not real mtpRequestId.
+	crl::time _preloadSent = 0;
+	crl::time _preloadDownSent = 0;
+	crl::time _preloadLatency = 0;
+	crl::time _preloadScrolled = 0;
+	int _preloadScrollTop = 0;
+	int _preloadScrollTopMax = 0;
+	float64 _preloadVelocity = 0.; // Pixels per ms, negative going up.
 
 	MsgId _delayedShowAtMsgId = -1;
 	Window::SectionShow _delayedShowAtMsgParams;
 	int _delayedShowAtRequest = 0; // Not real mtpRequestId.
 
-	History *_supportPreloadHistory = nullptr;
-	int _supportPreloadRequest = 0; // Not real mtpRequestId.
+	std::unique_ptr<Support::Preloader> _supportPreloader;
 
 	object_ptr<HistoryView::TopBarWidget> _topBar;
 	object_ptr<Ui::ContinuousScroll> _scroll;
@@ -1058,6 +1058,7 @@ void Element::overrideMedia(std::unique_ptr<Media> media) {
 	_text = Ui::Text::String(st::msgMinWidth);
 	_textWidth = -1;
 	_textHeight = 0;
+	_textLayoutKey = {};
 
 	_media = std::move(media);
 	if (!pendingResize()) {
@@ -1202,7 +1203,10 @@ int Element::textHeightFor(int textWidth) {
 	validateText();
 	if (_textWidth != textWidth) {
 		_textWidth = textWidth;
-		_textHeight = _text.countHeight(textWidth);
+		_textHeight = CountTextHeightCached(
+			_textLayoutKey,
+			_text,
+			textWidth);
 	}
 	return _textHeight;
 }
@@ -1430,11 +1434,19 @@ void Element::setTextWithLinks(
 			// Link indices start with 1.
 			_text.setLink(++linkIndex, link);
 		}
+		_textLayoutKey = {
+			.content = TextLayoutContentHash(text, options.flags),
+			.st = &st::serviceTextStyle,
+		};
 	} else {
 		const auto item = data();
 		const auto &options = Ui::ItemTextOptions(item);
 		clearSpecialOnlyEmoji();
 		_text.setMarkedText(st::messageTextStyle, text, options, context);
+		_textLayoutKey = {
+			.content = TextLayoutContentHash(text, options.flags),
+			.st = &st::messageTextStyle,
+		};
 		if (!item->_text.empty() && _text.isEmpty()){
 			// If server has allowed some text that we've trim-ed entirely,
 			// just replace it with something so that UI won't look buggy.
@@ -1464,6 +1476,8 @@ void Element::validateTextSkipBlock(bool has, int width, int height) {
 		_textWidth = -1;
 		_textHeight = 0;
 	}
+	_textLayoutKey.skipWidth = has ? width : 0;
+	_textLayoutKey.skipHeight = has ? height : 0;
 }
 
 void Element::previousInBlocksChanged() {
@@ -2056,6 +2070,7 @@ void Element::itemTextUpdated() {
 	_text = Ui::Text::String(st::msgMinWidth);
 	_textWidth = -1;
 	_textHeight = 0;
+	_textLayoutKey = {};
 	if (_media && !data()->media()) {
 		refreshMedia(nullptr);
 	}
@@ -2064,6 +2079,9 @@ void Element::itemTextUpdated() {
 void Element::blockquoteExpandChanged() {
 	_textWidth = -1;
 	_textHeight = 0;
+
+	// Expanded quotes are per-view state, don't share this layout.
+	_textLayoutKey = {};
 	history()->owner().requestViewResize(this);
 }
 
@@ -8,6 +8,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #pragma once
 
 #include "history/view/history_view_object.h"
+#include "history/view/history_view_text_layout_cache.h"
 #include "base/runtime_composer.h"
 #include "base/flags.h"
 #include "base/weak_ptr.h"
@@ -749,6 +750,7 @@ private:
 	mutable Ui::Text::String _text;
 	mutable int _textWidth = -1;
 	mutable int _textHeight = 0;
+	TextLayoutKey _textLayoutKey;
 
 	int _y = 0;
 	int _indexInBlock = -1;
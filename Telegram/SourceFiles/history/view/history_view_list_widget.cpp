@@ -1139,6 +1139,10 @@ void ListWidget::visibleTopBottomUpdated(
 	}
 	_delegate->listVisibleAreaUpdated();
 	session().data().itemVisibilitiesUpdated();
+	session().data().setHeavyViewPartsVisible(
+		this,
+		_visibleTop,
+		_visibleBottom);
 	_applyUpdatedScrollState.call();
 
 	_emojiInteractions->visibleAreaUpdated(_visibleTop, _visibleBottom);
@@ -4299,6 +4303,8 @@ void ListWidget::overrideChatMode(std::optional<ElementChatMode> mode) {
 }
 
 ListWidget::~ListWidget() {
+	session().data().unloadHeavyViewParts(this);
+
 	// Destroy child widgets first, because they may invoke leaveEvent-s.
 	_emptyInfo = nullptr;
 	if (const auto raw = _menu.release()) {
@@ -1090,6 +1090,7 @@ void Message::draw(Painter &p, const PaintContext &context) const {
 	if (g.width() < 1) {
 		return;
 	}
+	history()->owner().markHeavyViewPartUsed(const_cast<Message*>(this));
 
 	const auto item = data();
 	const auto media = this->media();
@@ -177,6 +177,10 @@ bool SendActionPainter::paint(
 	return false;
 }
 
+bool SendActionPainter::animating() const {
+	return _sendActionAnimation || _speakingAnimation;
+}
+
 void SendActionPainter::paintSpeaking(
 		QPainter &p,
 		int x,
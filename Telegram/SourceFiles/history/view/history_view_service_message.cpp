@@ -17,6 +17,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_abstract_structure.h"
 #include "data/data_chat.h"
 #include "data/data_channel.h"
+#include "data/data_session.h"
 #include "data/data_todo_list.h"
 #include "info/profile/info_profile_cover.h"
 #include "ui/chat/chat_style.h"
@@ -552,6 +553,7 @@ void Service::draw(Painter &p, const PaintContext &context) const {
 	if (g.width() < 1) {
 		return;
 	}
+	history()->owner().markHeavyViewPartUsed(const_cast<Service*>(this));
 
 	const auto st = context.st;
 	if (const auto bar = Get<UnreadBar>()) {
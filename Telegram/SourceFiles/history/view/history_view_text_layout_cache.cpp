@@ -0,0 +1,182 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "history/view/history_view_text_layout_cache.h"
+
+#include <xxhash.h>
+
+namespace HistoryView {
+namespace {
+
+constexpr auto kMaxEntries = 4096;
+constexpr auto kMaxWidthsPerEntry = 8;
+constexpr auto kLogEachLookups = 16384;
+
+struct Breakpoint {
+	int width = 0;
+	int height = 0;
+};
+
+struct Entry {
+	std::vector<Breakpoint> breakpoints; // Sorted by width.
+	uint64 lastUsed = 0;
+};
+
+struct KeyHash {
+	size_t operator()(const TextLayoutKey &key) const {
+		const uint64 values[] = {
+			key.content,
+			uint64(reinterpret_cast<uintptr_t>(key.st)),
+			(uint64(uint32(key.skipWidth)) << 32)
+				| uint64(uint32(key.skipHeight)),
+		};
+		return size_t(XXH64(values, sizeof(values), 0));
+	}
+};
+
+struct Cache {
+	std::unordered_map<TextLayoutKey, Entry, KeyHash> entries;
+	uint64 counter = 0;
+
+	uint64 lookups = 0;
+	uint64 singleLine = 0;
+	uint64 hits = 0;
+	uint64 misses = 0;
+};
+
+[[nodiscard]] Cache &GlobalCache() {
+	static auto result = Cache();
+	return result;
+}
+
+[[nodiscard]] uint64 HashString(const QString &value, uint64 seed) {
+	return XXH64(value.constData(), value.size() * sizeof(QChar), seed);
+}
+
+void Shrink(Cache &cache) {
+	// Drop the least recently used half at once, so the scan is amortized.
+	// Erasing from the hash map is constant, the whole pass is linear.
+	auto stamps = cache.entries | ranges::views::transform([](
+			const auto &pair) {
+		return pair.second.lastUsed;
+	}) | ranges::to_vector;
+	const auto middle = begin(stamps) + (stamps.size() / 2);
+	ranges::nth_element(stamps, middle);
+	const auto border = *middle;
+	auto &entries = cache.entries;
+	for (auto i = begin(entries); i != end(entries);) {
+		if (i->second.lastUsed < border) {
+			i = entries.erase(i);
+		} else {
+			++i;
+		}
+	}
+}
+
+void Remember(Entry &entry, int width, int height) {
+	auto &list = entry.breakpoints;
+	if (list.size() >= kMaxWidthsPerEntry) {
+		// Forget the width farthest from the current one.
+		const auto distance = [&](const Breakpoint &point) {
+			return std::abs(point.width - width);
+		};
+		list.erase(ranges::max_element(list, ranges::less(), distance));
+	}
+	const auto i = ranges::lower_bound(list, width, ranges::less(), [](
+			const Breakpoint &point) {
+		return point.width;
+	});
+	list.insert(i, Breakpoint{ width, height });
+}
+
+[[nodiscard]] std::optional<int> Find(const Entry &entry, int width) {
+	const auto &list = entry.breakpoints;
+	const auto i = ranges::lower_bound(list, width, ranges::less(), [](
+			const Breakpoint &point) {
+		return point.width;
+	});
+	// Only exact widths are reused, justified text may break into more
+	// lines at a larger width, so neighbour widths tell nothing.
+	return (i != end(list) && i->width == width)
+		? std::make_optional(i->height)
+		: std::nullopt;
+}
+
+void Log(const Cache &cache) {
+	DEBUG_LOG(("Text Layout Cache: %1 lookups, %2 single line, %3 hits, "
+		"%4 missed, %5 entries."
+		).arg(cache.lookups
+		).arg(cache.singleLine
+		).arg(cache.hits
+		).arg(cache.misses
+		).arg(cache.entries.size()));
+}
+
+} // namespace
+
+uint64 TextLayoutContentHash(
+		const TextWithEntities &text,
+		int32 parseFlags) {
+	auto result = HashString(text.text, uint64(uint32(parseFlags)));
+	for (const auto &entity : text.entities) {
+		const int32 values[] = {
+			int32(entity.type()),
+			int32(entity.offset()),
+			int32(entity.length()),
+		};
+		result = XXH64(values, sizeof(values), result);
+		result = HashString(entity.data(), result);
+	}
+	// Zero is reserved for "not shareable".
+	return result ? result : 1;
+}
+
+int CountTextHeightCached(
+		const TextLayoutKey &key,
+		const Ui::Text::String &text,
+		int width) {
+	if (!key) {
+		return text.countHeight(width);
+	}
+	auto &cache = GlobalCache();
+	if (!(++cache.lookups % kLogEachLookups)) {
+		Log(cache);
+	}
+	if (width >= text.maxWidth()) {
+		++cache.singleLine;
+		return text.minHeight();
+	}
+	auto i = cache.entries.find(key);
+	if (i != end(cache.entries)) {
+		i->second.lastUsed = ++cache.counter;
+		if (const auto height = Find(i->second, width)) {
+			++cache.hits;
+			return *height;
+		}
+	}
+	++cache.misses;
+	const auto height = text.countHeight(width);
+	if (i == end(cache.entries)) {
+		if (cache.entries.size() >= kMaxEntries) {
+			Shrink(cache);
+		}
+		i = cache.entries.emplace(key, Entry()).first;
+		i->second.lastUsed = ++cache.counter;
+	}
+	Remember(i->second, width, height);
+	return height;
+}
+
+void ClearTextLayoutCache() {
+	auto &cache = GlobalCache();
+	if (cache.lookups) {
+		Log(cache);
+	}
+	cache = Cache();
+}
+
+} // namespace HistoryView
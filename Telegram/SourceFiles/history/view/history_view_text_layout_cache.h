@@ -0,0 +1,45 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+namespace style {
+struct TextStyle;
+} // namespace style
+
+namespace HistoryView {
+
+// Identifies a laid out paragraph independently of the element owning it,
+// so that identical texts (forwards, repeated bot messages) share results.
+struct TextLayoutKey {
+	uint64 content = 0;
+	const style::TextStyle *st = nullptr;
+	int skipWidth = 0;
+	int skipHeight = 0;
+
+	explicit operator bool() const {
+		return (content != 0);
+	}
+	friend inline bool operator==(
+		const TextLayoutKey &,
+		const TextLayoutKey &) = default;
+};
+
+[[nodiscard]] uint64 TextLayoutContentHash(
+	const TextWithEntities &text,
+	int32 parseFlags);
+
+// Returns text.countHeight(width), reusing results computed for the same
+// key at exactly this width.
+[[nodiscard]] int CountTextHeightCached(
+	const TextLayoutKey &key,
+	const Ui::Text::String &text,
+	int width);
+
+void ClearTextLayoutCache();
+
+} // namespace HistoryView
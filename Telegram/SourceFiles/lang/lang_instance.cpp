@@ -237,6 +237,7 @@ struct Instance::PrivateTag {
 
 Instance::Instance()
 : _values(PrepareDefaultValues())
+, _unparsed(kKeysCount)
 , _nonDefaultSet(kKeysCount, 0) {
 }
 
@@ -293,10 +294,15 @@ void Instance::reset(const Language &data) {
 	_customFileContent = QByteArray();
 	_version = 0;
 	_nonDefaultValues.clear();
-	for (auto i = 0, count = int(_values.size()); i != count; ++i) {
-		_values[i] = GetOriginalValue(ushort(i));
+	{
+		QMutexLocker lock(&_parseMutex);
+		for (auto i = 0, count = int(_values.size()); i != count; ++i) {
+			_values[i] = GetOriginalValue(ushort(i));
+		}
+		ranges::fill(_unparsed, Unparsed());
+		ranges::fill(_nonDefaultSet, 0);
+		_unparsedCount = 0;
 	}
-	ranges::fill(_nonDefaultSet, 0);
 	updateChoosingStickerReplacement();
 
 	_idChanges.fire_copy(_id);
@@ -728,22 +734,64 @@ QString Instance::getNonDefaultValue(const QByteArray &key) const {
 
 void Instance::applyValue(const QByteArray &key, const QByteArray &value) {
 	_nonDefaultValues[key] = value;
-	ParseKeyValue(key, value, [&](ushort key, QString &&value) {
-		_nonDefaultSet[key] = 1;
-		if (!_derived) {
-			_values[key] = std::move(value);
-		} else if (!_derived->_nonDefaultSet[key]) {
-			_derived->_values[key] = std::move(value);
+	const auto index = GetKeyIndex(QLatin1String(key));
+	if (index == kKeysCount) {
+		if (!key.startsWith("cloud_")) {
+			DEBUG_LOG(("Lang Warning: Unknown key '%1'"
+				).arg(QString::fromLatin1(key)));
 		}
-		if (key == tr::lng_send_action_choose_sticker.base
-			|| key == tr::lng_user_action_choose_sticker.base) {
-			if (!_derived) {
-				updateChoosingStickerReplacement();
-			} else {
-				_derived->updateChoosingStickerReplacement();
-			}
+		return;
+	}
+	if (!_derived) {
+		QMutexLocker lock(&_parseMutex);
+		_nonDefaultSet[index] = 1;
+		setUnparsed(index, { key, value, true });
+	} else {
+		QMutexLocker lock(&_derived->_parseMutex);
+		_nonDefaultSet[index] = 1;
+		if (!_derived->_nonDefaultSet[index]) {
+			_derived->setUnparsed(index, { key, value });
 		}
-	});
+	}
+	if (index == tr::lng_send_action_choose_sticker.base
+		|| index == tr::lng_user_action_choose_sticker.base) {
+		if (!_derived) {
+			updateChoosingStickerReplacement();
+		} else {
+			_derived->updateChoosingStickerReplacement();
+		}
+	}
+}
+
+void Instance::setUnparsed(ushort key, Unparsed value) {
+	if (_unparsed[key].key.isEmpty()) {
+		++_unparsedCount;
+	}
+	_unparsed[key] = std::move(value);
+}
+
+void Instance::clearUnparsed(ushort key) {
+	if (!_unparsed[key].key.isEmpty()) {
+		_unparsed[key] = Unparsed();
+		--_unparsedCount;
+	}
+}
+
+QString Instance::getValueParsed(ushort key) const {
+	QMutexLocker lock(&_parseMutex);
+	if (_unparsed[key].key.isEmpty()) {
+		return _values[key];
+	}
+	const auto unparsed = base::take(_unparsed[key]);
+	auto parser = ValueParser(unparsed.key, key, unparsed.value);
+	if (parser.parse()) {
+		_values[key] = parser.takeResult();
+	} else if (unparsed.own) {
+		// Keep the previous value, as if this one was never applied.
+		_nonDefaultSet[key] = 0;
+	}
+	--_unparsedCount;
+	return _values[key];
 }
 
 void Instance::updatePluralRules() {
@@ -762,16 +810,23 @@ void Instance::resetValue(const QByteArray &key) {
 
 	const auto keyIndex = GetKeyIndex(QLatin1String(key));
 	if (keyIndex != kKeysCount) {
-		_nonDefaultSet[keyIndex] = 0;
 		if (!_derived) {
 			const auto base = _base
 				? _base->getNonDefaultValue(key)
 				: QString();
+			QMutexLocker lock(&_parseMutex);
+			_nonDefaultSet[keyIndex] = 0;
 			_values[keyIndex] = !base.isEmpty()
 				? base
 				: GetOriginalValue(keyIndex);
-		} else if (!_derived->_nonDefaultSet[keyIndex]) {
-			_derived->_values[keyIndex] = GetOriginalValue(keyIndex);
+			clearUnparsed(keyIndex);
+		} else {
+			QMutexLocker lock(&_derived->_parseMutex);
+			_nonDefaultSet[keyIndex] = 0;
+			if (!_derived->_nonDefaultSet[keyIndex]) {
+				_derived->_values[keyIndex] = GetOriginalValue(keyIndex);
+				_derived->clearUnparsed(keyIndex);
+			}
 		}
 		if (keyIndex == tr::lng_send_action_choose_sticker.base
 			|| keyIndex == tr::lng_user_action_choose_sticker.base) {
@@ -11,6 +11,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "base/const_string.h"
 #include "base/weak_ptr.h"
 
+#include <atomic>
+
 namespace Lang {
 
 inline constexpr auto kChoosingStickerReplacement = "oo"_cs;
@@ -92,6 +94,9 @@ public:
 	QString getValue(ushort key) const {
 		Expects(key < _values.size());
 
+		if (_unparsedCount.load(std::memory_order_acquire) > 0) {
+			return getValueParsed(key);
+		}
 		return _values[key];
 	}
 	QString getNonDefaultValue(const QByteArray &key) const;
@@ -108,6 +113,12 @@ public:
 	}
 
 private:
+	struct Unparsed {
+		QByteArray key;
+		QByteArray value;
+		bool own = false;
+	};
+
 	void setBaseId(const QString &baseId, const QString &pluralId);
 
 	void applyDifferenceToMe(const MTPDlangPackDifference &difference);
@@ -123,6 +134,9 @@ private:
 		const QString &relativePath,
 		const QByteArray &content);
 	void updateChoosingStickerReplacement();
+	void setUnparsed(ushort key, Unparsed value);
+	void clearUnparsed(ushort key);
+	[[nodiscard]] QString getValueParsed(ushort key) const;
 
 	Instance *_derived = nullptr;
 
@@ -143,8 +157,15 @@ private:
 
 	mutable QString _systemLanguage;
 
-	std::vector<QString> _values;
-	std::vector<uchar> _nonDefaultSet;
+	// Applied values are kept raw until first accessed, most of the keys
+	// are never shown in a session and parsing them all delays startup.
+	// Values are read from any thread, so while some are left unparsed
+	// reads, parsing and changes of them go under the mutex.
+	mutable std::vector<QString> _values;
+	mutable std::vector<Unparsed> _unparsed;
+	mutable std::atomic<int> _unparsedCount = 0;
+	mutable QMutex _parseMutex;
+	mutable std::vector<uchar> _nonDefaultSet;
 	std::map<QByteArray, QByteArray> _nonDefaultValues;
 
 	std::unique_ptr<Instance> _base;
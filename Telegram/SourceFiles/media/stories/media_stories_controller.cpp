@@ -798,18 +798,33 @@ void Controller::rebuildFromContext(
 void Controller::preloadNext() {
 	Expects(shown());
 
+	// Ordered by how likely the user is to go there next:
+	// the following story, the next source, the rest of this source,
+	// then going back inside this source or to the previous source.
 	auto ids = std::vector<FullStoryId>();
-	ids.reserve(kPreloadPreviousMediaCount + kPreloadNextMediaCount);
+	ids.reserve(kPreloadPreviousMediaCount + kPreloadNextMediaCount + 2);
 	const auto peer = shownPeer();
 	const auto count = shownCount();
 	const auto till = std::min(_index + kPreloadNextMediaCount, count);
-	for (auto i = _index + 1; i != till; ++i) {
+	const auto pushSibling = [&](const std::unique_ptr<Sibling> &sibling) {
+		if (sibling) {
+			if (const auto id = sibling->shownId(); id.valid()) {
+				ids.push_back(id);
+			}
+		}
+	};
+	if (_index + 1 < till) {
+		ids.push_back({ .peer = peer->id, .story = shownId(_index + 1) });
+	}
+	pushSibling(_siblingRight);
+	for (auto i = _index + 2; i < till; ++i) {
 		ids.push_back({ .peer = peer->id, .story = shownId(i) });
 	}
 	const auto from = std::max(_index - kPreloadPreviousMediaCount, 0);
 	for (auto i = _index; i != from;) {
 		ids.push_back({ .peer = peer->id, .story = shownId(--i) });
 	}
+	pushSibling(_siblingLeft);
 	peer->owner().stories().setPreloadingInViewer(std::move(ids));
 }
 
@@ -969,6 +984,8 @@ bool Controller::changeShown(Data::Story *story) {
 	}
 
 	_viewed = false;
+	_shownAt = story ? crl::now() : 0;
+	_shownPreloaded = story && story->owner().stories().preloaded(id);
 	invalidate_weak_ptrs(&_viewsLoadGuard);
 	_reactions->hide();
 	_reactions->setReactionIconWidget(nullptr);
@@ -1175,6 +1192,13 @@ void Controller::ready() {
 		return;
 	}
 	_started = true;
+	if (const auto shownAt = base::take(_shownAt)) {
+		DEBUG_LOG(("Stories: First frame of %1:%2 in %3ms, %4."
+			).arg(_shown.peer.value
+			).arg(_shown.story
+			).arg(crl::now() - shownAt
+			).arg(_shownPreloaded ? "preloaded" : "not preloaded"));
+	}
 	updatePlayingAllowed();
 	_reactions->ready();
 }
@@ -301,6 +301,8 @@ private:
 	int _sliderCount = 0;
 	bool _started = false;
 	bool _viewed = false;
+	crl::time _shownAt = 0;
+	bool _shownPreloaded = false;
 
 	std::vector<Data::StoryLocation> _locations;
 	std::vector<Data::SuggestedReaction> _suggestedReactions;
@@ -122,6 +122,9 @@ constexpr auto kSeekTimeMs = 5 * crl::time(1000);
 // even though it reports that max texture size is 16384.
 constexpr auto kMaxDisplayImageSize = 4096;
 
+// Don't keep more than that in photos scaled ahead of time.
+constexpr auto kMaxPreparedPhotosSize = int64(64 * 1024 * 1024);
+
 // Preload X message ids before and after current.
 constexpr auto kIdsLimit = 48;
 
@@ -345,6 +348,11 @@ struct OverlayWidget::Streamed {
 	bool resumeOnCallEnd = false;
 };
 
+struct OverlayWidget::PreparedPhoto {
+	QSize size;
+	QImage image;
+};
+
 struct OverlayWidget::PipWrap {
 	PipWrap(
 		QWidget *parent,
@@ -4937,6 +4945,16 @@ void OverlayWidget::validatePhotoImage(Image *image, bool blurred) {
 	}
 	const auto use = flipSizeByRotation({ _width, _height })
 		* style::DevicePixelRatio();
+	if (!blurred && _photo) {
+		const auto i = _preparedPhotos.find(_photo);
+		if (i != end(_preparedPhotos)
+			&& i->second->size == use
+			&& !i->second->image.isNull()) {
+			setStaticContent(i->second->image);
+			_blurred = false;
+			return;
+		}
+	}
 	setStaticContent(image->pixNoCache(
 		use,
 		{ .options = (blurred ? Images::Option::Blur : Images::Option()) }
@@ -5887,6 +5905,7 @@ void OverlayWidget::setSession(not_null<Main::Session*> session) {
 		if (!isHidden()) {
 			updateControls();
 			checkForSaveLoaded();
+			preparePhotosAhead();
 		}
 	}, _sessionLifetime);
 
@@ -5960,12 +5979,20 @@ void OverlayWidget::preloadData(int delta) {
 
 	auto photos = base::flat_set<std::shared_ptr<Data::PhotoMedia>>();
 	auto documents = base::flat_set<std::shared_ptr<Data::DocumentMedia>>();
+	auto order = std::vector<std::pair<int, not_null<PhotoData*>>>();
 	for (auto index = from; index != till + 1; ++index) {
 		auto entity = entityByIndex(index);
 		if (auto photo = std::get_if<not_null<PhotoData*>>(&entity.data)) {
 			const auto &[i, ok] = photos.emplace((*photo)->createMediaView());
 			(*i)->wanted(Data::PhotoSize::Small, fileOrigin(entity));
 			(*photo)->load(fileOrigin(entity), LoadFromCloudOrLocal, true);
+
+			// Nearest first, the direction of movement wins the ties.
+			const auto distance = (index - *_index) * ((delta < 0) ? -1 : 1);
+			const auto rank = (distance > 0)
+				? (2 * distance - 1)
+				: (-2 * distance);
+			order.emplace_back(rank, *photo);
 		} else if (auto document = std::get_if<not_null<DocumentData*>>(
 				&entity.data)) {
 			const auto &[i, ok] = documents.emplace(
@@ -5978,6 +6005,77 @@ void OverlayWidget::preloadData(int delta) {
 	}
 	_preloadPhotos = std::move(photos);
 	_preloadDocuments = std::move(documents);
+
+	ranges::sort(order, ranges::less(), [](const auto &pair) {
+		return pair.first;
+	});
+	_preparePhotosOrder = order | ranges::views::transform([](
+			const auto &pair) {
+		return pair.second;
+	}) | ranges::to_vector;
+	preparePhotosAhead();
+}
+
+QSize OverlayWidget::preparedPhotoSize(not_null<PhotoData*> photo) const {
+	// The same size validatePhotoImage() will ask for this photo.
+	return style::ConvertScale(QSize(photo->width(), photo->height()))
+		* style::DevicePixelRatio();
+}
+
+void OverlayWidget::preparePhotosAhead() {
+	// Scale loaded neighbour photos to their display size on a worker
+	// thread, so that flipping to them doesn't do it on the main thread.
+	auto wanted = base::flat_map<not_null<PhotoData*>, QSize>();
+	auto total = int64();
+	for (const auto photo : _preparePhotosOrder) {
+		const auto size = preparedPhotoSize(photo);
+		total += int64(size.width()) * size.height() * 4;
+		if (total > kMaxPreparedPhotosSize) {
+			break;
+		}
+		wanted.emplace(photo, size);
+	}
+
+	// Stale work is dropped, f.e. after the user changed the direction.
+	for (auto i = begin(_preparedPhotos); i != end(_preparedPhotos);) {
+		const auto j = wanted.find(i->first);
+		if (j == end(wanted) || j->second != i->second->size) {
+			i = _preparedPhotos.erase(i);
+		} else {
+			++i;
+		}
+	}
+
+	for (const auto &media : _preloadPhotos) {
+		const auto photo = media->owner();
+		const auto j = wanted.find(photo);
+		if (j == end(wanted)
+			|| photo == _photo
+			|| _preparedPhotos.contains(photo)) {
+			continue;
+		}
+		const auto image = media->image(Data::PhotoSize::Large);
+		if (!image) {
+			continue;
+		}
+		const auto size = j->second;
+		const auto prepared = std::make_shared<PreparedPhoto>(
+			PreparedPhoto{ .size = size });
+		_preparedPhotos.emplace(photo, prepared);
+
+		const auto weak = std::weak_ptr<PreparedPhoto>(prepared);
+		crl::async([=, original = image->original()] {
+			if (weak.expired()) {
+				return;
+			}
+			auto result = Images::Prepare(original, size, {});
+			crl::on_main([=, result = std::move(result)]() mutable {
+				if (const auto strong = weak.lock()) {
+					strong->image = std::move(result);
+				}
+			});
+		});
+	}
 }
 
 void OverlayWidget::handleMousePress(
@@ -6649,6 +6747,8 @@ void OverlayWidget::clearBeforeHide() {
 	assignMediaPointer(nullptr);
 	_preloadPhotos.clear();
 	_preloadDocuments.clear();
+	_preparePhotosOrder.clear();
+	_preparedPhotos.clear();
 	if (_menu) {
 		_menu->hideMenu(true);
 	}
@@ -129,6 +129,7 @@ private:
 	class Show;
 	struct Streamed;
 	struct PipWrap;
+	struct PreparedPhoto;
 	struct ItemContext;
 	struct StoriesContext;
 	class Renderer;
@@ -309,6 +310,8 @@ private:
 	void updateGeometryToScreen(bool inMove = false);
 	bool moveToNext(int delta);
 	void preloadData(int delta);
+	void preparePhotosAhead();
+	[[nodiscard]] QSize preparedPhotoSize(not_null<PhotoData*> photo) const;
 
 	void handleScreenChanged(not_null<QScreen*> screen);
 
@@ -563,6 +566,10 @@ private:
 	std::shared_ptr<Data::PhotoMedia> _videoCoverMedia;
 	base::flat_set<std::shared_ptr<Data::PhotoMedia>> _preloadPhotos;
 	base::flat_set<std::shared_ptr<Data::DocumentMedia>> _preloadDocuments;
+	std::vector<not_null<PhotoData*>> _preparePhotosOrder;
+	base::flat_map<
+		not_null<PhotoData*>,
+		std::shared_ptr<PreparedPhoto>> _preparedPhotos;
 	int _rotation = 0;
 	std::unique_ptr<SharedMedia> _sharedMedia;
 	std::optional<SharedMediaWithLastSlice> _sharedMediaData;
@@ -428,9 +428,9 @@ void Photo::setPixFrom(not_null<Image*> image) {
 
 	// In case we have inline thumbnail we can unload all images and we still
 	// won't get a blank image in the media viewer when the photo is opened.
+	// The item stays registered as heavy until the frame is cleared.
 	if (!_data->inlineThumbnailBytes().isEmpty()) {
 		_dataMedia = nullptr;
-		delegate()->unregisterHeavyItem(this);
 	}
 }
 
@@ -474,6 +474,9 @@ void Photo::itemDataChanged() {
 
 void Photo::clearHeavyPart() {
 	_dataMedia = nullptr;
+	_pix = QImage();
+	_hiddenBgCache = QImage();
+	_goodLoaded = false;
 }
 
 TextState Photo::getState(
@@ -722,6 +725,9 @@ void Video::itemDataChanged() {
 
 void Video::clearHeavyPart() {
 	_dataMedia = nullptr;
+	_videoCoverMedia = nullptr;
+	_pix = QImage();
+	_hiddenBgCache = QImage();
 }
 
 float64 Video::dataProgress() const {
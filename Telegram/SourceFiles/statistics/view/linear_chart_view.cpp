@@ -35,9 +35,9 @@ void PaintChartLine(
 
 	const auto ratio = ratios.ratio(line.id);
 
-	for (auto i = localStart; i <= localEnd; i++) {
+	const auto addPoint = [&](int i) {
 		if (line.y[i] < 0) {
-			continue;
+			return;
 		}
 		const auto xPoint = c.rect.width()
 			* ((c.chartData.xPercentage[i] - c.xPercentageLimits.min)
@@ -46,6 +46,33 @@ void PaintChartLine(
 			/ float64(c.heightLimits.max - c.heightLimits.min);
 		const auto yPoint = (1. - yPercentage) * c.rect.height();
 		chartPoints << QPointF(xPoint, yPoint);
+	};
+
+	// Use the coarsest detail level that still has a bucket per column.
+	const auto &levels = line.detailLevels;
+	const auto perColumn = (localEnd - localStart + 1)
+		/ std::max(c.rect.width(), 1);
+	auto level = 0;
+	while (level < int(levels.size()) && (2 << level) <= perColumn) {
+		++level;
+	}
+	if (!level) {
+		for (auto i = localStart; i <= localEnd; i++) {
+			addPoint(i);
+		}
+	} else {
+		const auto &indices = levels[level - 1];
+		const auto till = (localEnd >> level);
+		for (auto bucket = (localStart >> level); bucket <= till; ++bucket) {
+			const auto first = indices[bucket * 2];
+			const auto second = indices[bucket * 2 + 1];
+			if (first >= 0) {
+				addPoint(first);
+				if (second != first) {
+					addPoint(second);
+				}
+			}
+		}
 	}
 	p.setPen(QPen(
 		line.color,
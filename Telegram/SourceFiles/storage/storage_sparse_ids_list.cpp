@@ -8,6 +8,11 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "storage/storage_sparse_ids_list.h"
 
 namespace Storage {
+namespace {
+
+constexpr auto kInsertSeparatelyLimit = 4;
+
+} // namespace
 
 SparseIdsList::Slice::Slice(
 	base::flat_set<MsgId> &&messages,
@@ -23,7 +28,17 @@ void SparseIdsList::Slice::merge(
 	Expects(moreNoSkipRange.from <= range.till);
 	Expects(range.from <= moreNoSkipRange.till);
 
-	messages.merge(std::begin(moreMessages), std::end(moreMessages));
+	const auto count = std::distance(
+		std::begin(moreMessages),
+		std::end(moreMessages));
+	if (count <= kInsertSeparatelyLimit) {
+		// Most updates bring a single new message, don't re-sort for it.
+		for (const auto messageId : moreMessages) {
+			messages.insert(messageId);
+		}
+	} else {
+		messages.merge(std::begin(moreMessages), std::end(moreMessages));
+	}
 	range = {
 		qMin(range.from, moreNoSkipRange.from),
 		qMax(range.till, moreNoSkipRange.till)
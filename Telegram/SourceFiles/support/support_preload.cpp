@@ -18,10 +18,14 @@ namespace Support {
 namespace {
 
 constexpr auto kPreloadMessagesCount = 50;
+constexpr auto kMaxConcurrentRequests = 2;
 
 } // namespace
 
-int SendPreloadRequest(not_null<History*> history, Fn<void()> retry) {
+int SendPreloadRequest(
+		not_null<History*> history,
+		Fn<void()> retry,
+		Fn<void(bool loaded)> done) {
 	auto offsetId = MsgId();
 	auto offset = 0;
 	auto loadCount = kPreloadMessagesCount;
@@ -68,10 +72,118 @@ int SendPreloadRequest(not_null<History*> history, Fn<void()> retry) {
 				history->addOlderSlice(data.vmessages().v);
 			});
 			finish();
+			if (done) {
+				done(true);
+			}
 		}).fail([=](const MTP::Error &error) {
 			finish();
+			if (done) {
+				done(false);
+			}
 		}).send();
 	});
 }
 
+Preloader::Preloader(not_null<Main::Session*> session)
+: _session(session) {
+}
+
+Preloader::~Preloader() {
+	cancel();
+	log();
+}
+
+void Preloader::preload(const std::vector<not_null<History*>> &upcoming) {
+	_upcoming = upcoming;
+	const auto requested = _requests | ranges::views::keys | ranges::to_vector;
+	for (const auto history : requested) {
+		if (!ranges::contains(_upcoming, history)) {
+			cancel(history);
+		}
+	}
+	for (auto i = begin(_ready); i != end(_ready);) {
+		if (!ranges::contains(_upcoming, *i)) {
+			i = _ready.erase(i);
+		} else {
+			++i;
+		}
+	}
+	sendNext();
+}
+
+void Preloader::sendNext() {
+	for (const auto history : _upcoming) {
+		if (_requests.size() >= kMaxConcurrentRequests) {
+			return;
+		} else if (_requests.contains(history) || _ready.contains(history)) {
+			continue;
+		}
+		const auto weak = base::make_weak(this);
+		const auto requestId = SendPreloadRequest(history, [=] {
+			crl::on_main(weak, [=] {
+				cancel(history);
+				sendNext();
+			});
+		}, [=](bool loaded) {
+			if (!weak) {
+				return;
+			}
+			_requests.remove(history);
+			if (loaded) {
+				_ready.emplace(history);
+			} else {
+				// Don't retry the failed one until the queue changes.
+				forget(history);
+			}
+			sendNext();
+		});
+		_requests.emplace(history, requestId);
+	}
+}
+
+void Preloader::opened(not_null<History*> history) {
+	if (_ready.remove(history)) {
+		++_hits;
+	} else {
+		++_misses;
+	}
+	// The opened history loads itself, don't unload it under its feet.
+	cancel(history);
+	forget(history);
+	DEBUG_LOG(("Support Preload: %1 hits, %2 misses."
+		).arg(_hits
+		).arg(_misses));
+}
+
+void Preloader::cancel() {
+	auto &histories = _session->data().histories();
+	for (const auto &[history, requestId] : base::take(_requests)) {
+		histories.cancelRequest(requestId);
+	}
+	_upcoming.clear();
+	_ready.clear();
+}
+
+void Preloader::cancel(not_null<History*> history) {
+	if (const auto requestId = _requests.take(history)) {
+		_session->data().histories().cancelRequest(*requestId);
+	}
+}
+
+void Preloader::forget(not_null<History*> history) {
+	_upcoming.erase(ranges::remove(_upcoming, history), end(_upcoming));
+}
+
+bool Preloader::busy() const {
+	return !_requests.empty();
+}
+
+void Preloader::log() const {
+	if (_hits || _misses) {
+		DEBUG_LOG(("Support Preload: finished with %1 hits, %2 misses."
+			).arg(_hits
+			).arg(_misses));
+	}
+}
+
 } // namespace Support
@@ -7,13 +7,51 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 */
 #pragma once
 
+#include "base/weak_ptr.h"
+
 class History;
 
+namespace Main {
+class Session;
+} // namespace Main
+
 namespace Support {
 
 // Returns histories().request, not api().request.
 [[nodiscard]] int SendPreloadRequest(
 	not_null<History*> history,
-	Fn<void()> retry);
+	Fn<void()> retry,
+	Fn<void(bool loaded)> done = nullptr);
+
+// Keeps the next few chats of the support queue loaded in advance,
+// so that switching to them doesn't wait for the first slice.
+class Preloader final : public base::has_weak_ptr {
+public:
+	explicit Preloader(not_null<Main::Session*> session);
+	~Preloader();
+
+	// Histories in the order the operator is going to open them.
+	void preload(const std::vector<not_null<History*>> &upcoming);
+	void opened(not_null<History*> history);
+	void cancel();
+
+	[[nodiscard]] bool busy() const;
+
+private:
+	void sendNext();
+	void cancel(not_null<History*> history);
+	void forget(not_null<History*> history);
+	void log() const;
+
+	const not_null<Main::Session*> _session;
+
+	std::vector<not_null<History*>> _upcoming;
+	base::flat_map<not_null<History*>, int> _requests;
+	base::flat_set<not_null<History*>> _ready;
+
+	int _hits = 0;
+	int _misses = 0;
+
+};
 
 } // namespace Support
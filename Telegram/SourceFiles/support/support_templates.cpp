@@ -12,6 +12,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/shortcuts.h"
 #include "main/main_session.h"
 
+#include <QtCore/QSaveFile>
 #include <QtNetwork/QNetworkAccessManager>
 
 namespace Support {
@@ -20,6 +21,9 @@ namespace {
 
 constexpr auto kQueryLimit = 10;
 constexpr auto kWeightStep = 1000;
+constexpr auto kPrefixLength = 2;
+constexpr auto kCacheVersion = 1;
+const auto kCacheName = u"templates.cache"_q;
 
 struct Delta {
 	std::vector<const TemplatesQuestion*> added;
@@ -254,18 +258,193 @@ struct FilesResult {
 	QStringList errors;
 };
 
-FilesResult ReadFiles(const QString &folder) {
-	auto result = FilesResult();
-	const auto files = QDir(folder).entryList(QDir::Files);
+QStringList ComputeFilesStamp(
+		const QString &folder,
+		const QStringList &files) {
+	auto result = QStringList();
+	result.reserve(files.size());
 	for (const auto &path : files) {
-		if (!IsTemplatesFile(path)) {
-			continue;
+		const auto info = QFileInfo(folder + '/' + path);
+		result.push_back(u"%1/%2/%3"_q
+			.arg(path)
+			.arg(info.size())
+			.arg(info.lastModified().toMSecsSinceEpoch()));
+	}
+	return result;
+}
+
+[[nodiscard]] std::vector<TemplatesIndex::Id> CollectIds(
+		const TemplatesData &data) {
+	auto result = std::vector<TemplatesIndex::Id>();
+	for (const auto &[path, file] : data.files) {
+		for (const auto &[normalized, question] : file.questions) {
+			result.emplace_back(path, normalized);
 		}
-		auto file = ReadFile(folder + '/' + path);
-		if (!file.result.url.isEmpty() || !file.result.questions.empty()) {
-			result.result.files[path] = std::move(file.result);
+	}
+	return result;
+}
+
+void WriteCache(
+		const QString &folder,
+		const QStringList &stamp,
+		const FilesResult &files) {
+	// Write through a temporary file, so a crash doesn't leave it torn.
+	auto f = QSaveFile(folder + '/' + kCacheName);
+	if (!f.open(QIODevice::WriteOnly)) {
+		return;
+	}
+	auto stream = QDataStream(&f);
+	stream.setVersion(QDataStream::Qt_5_1);
+	stream << qint32(kCacheVersion) << stamp;
+
+	const auto &data = files.result;
+	stream << qint32(data.files.size());
+	for (const auto &[path, file] : data.files) {
+		stream << path << file.url << qint32(file.questions.size());
+		for (const auto &[normalized, question] : file.questions) {
+			stream
+				<< normalized
+				<< question.question
+				<< question.originalKeys
+				<< question.normalizedKeys
+				<< question.value;
+		}
+	}
+
+	// Questions are referenced by their position in the data.
+	const auto ids = CollectIds(data);
+	const auto indexOf = [&](const TemplatesIndex::Id &id) {
+		return qint32(ranges::lower_bound(ids, id) - begin(ids));
+	};
+	const auto &index = files.index;
+	stream << qint32(index.prefixes.size());
+	for (const auto &[prefix, list] : index.prefixes) {
+		stream << prefix << qint32(list.size());
+		for (const auto &id : list) {
+			stream << indexOf(id);
+		}
+	}
+	stream << qint32(index.full.size());
+	for (const auto &[id, terms] : index.full) {
+		stream << indexOf(id) << qint32(terms.size());
+		for (const auto &[term, weight] : terms) {
+			stream << term << qint32(weight);
 		}
-		result.errors.append(std::move(file.errors));
+	}
+	if (stream.status() == QDataStream::Ok) {
+		f.commit();
+	}
+}
+
+std::optional<FilesResult> ReadCache(
+		const QString &folder,
+		const QStringList &stamp) {
+	auto f = QFile(folder + '/' + kCacheName);
+	if (!f.open(QIODevice::ReadOnly)) {
+		return std::nullopt;
+	}
+	auto stream = QDataStream(&f);
+	stream.setVersion(QDataStream::Qt_5_1);
+
+	auto version = qint32();
+	auto cachedStamp = QStringList();
+	stream >> version >> cachedStamp;
+	if (stream.status() != QDataStream::Ok
+		|| version != kCacheVersion
+		|| cachedStamp != stamp) {
+		return std::nullopt;
+	}
+
+	// Each entry takes at least four bytes, so a count read from
+	// a corrupted file can't make us allocate more than the file has.
+	const auto goodCount = [&](qint32 count) {
+		return (stream.status() == QDataStream::Ok)
+			&& (count >= 0)
+			&& (count <= f.bytesAvailable() / int(sizeof(qint32)));
+	};
+	auto result = FilesResult();
+	auto filesCount = qint32();
+	stream >> filesCount;
+	if (!goodCount(filesCount)) {
+		return std::nullopt;
+	}
+	for (auto i = 0; i < filesCount; ++i) {
+		auto path = QString();
+		auto file = TemplatesFile();
+		auto questionsCount = qint32();
+		stream >> path >> file.url >> questionsCount;
+		if (!goodCount(questionsCount)) {
+			return std::nullopt;
+		}
+		for (auto j = 0; j < questionsCount; ++j) {
+			auto normalized = QString();
+			auto question = TemplatesQuestion();
+			stream
+				>> normalized
+				>> question.question
+				>> question.originalKeys
+				>> question.normalizedKeys
+				>> question.value;
+			file.questions.emplace(normalized, std::move(question));
+		}
+		if (stream.status() != QDataStream::Ok) {
+			return std::nullopt;
+		}
+		result.result.files.emplace(path, std::move(file));
+	}
+
+	const auto ids = CollectIds(result.result);
+	const auto readId = [&]() -> std::optional<TemplatesIndex::Id> {
+		auto index = qint32();
+		stream >> index;
+		return (index >= 0 && index < int(ids.size()))
+			? std::make_optional(ids[index])
+			: std::nullopt;
+	};
+	auto prefixesCount = qint32();
+	stream >> prefixesCount;
+	if (!goodCount(prefixesCount)) {
+		return std::nullopt;
+	}
+	for (auto i = 0; i < prefixesCount; ++i) {
+		auto prefix = QString();
+		auto count = qint32();
+		stream >> prefix >> count;
+		if (!goodCount(count)) {
+			return std::nullopt;
+		}
+		auto &list = result.index.prefixes[prefix];
+		for (auto j = 0; j < count; ++j) {
+			if (const auto id = readId()) {
+				list.push_back(*id);
+			} else {
+				return std::nullopt;
+			}
+		}
+	}
+	auto fullCount = qint32();
+	stream >> fullCount;
+	if (!goodCount(fullCount)) {
+		return std::nullopt;
+	}
+	for (auto i = 0; i < fullCount; ++i) {
+		const auto id = readId();
+		auto count = qint32();
+		stream >> count;
+		if (!id || !goodCount(count)) {
+			return std::nullopt;
+		}
+		auto &terms = result.index.full[*id];
+		terms.reserve(count);
+		for (auto j = 0; j < count; ++j) {
+			auto term = QString();
+			auto weight = qint32();
+			stream >> term >> weight;
+			terms.emplace_back(std::move(term), weight);
+		}
+	}
+	if (stream.status() != QDataStream::Ok) {
+		return std::nullopt;
 	}
 	return result;
 }
@@ -274,7 +453,7 @@ TemplatesIndex ComputeIndex(const TemplatesData &data) {
 	using Id = TemplatesIndex::Id;
 	using Term = TemplatesIndex::Term;
 
-	auto uniqueFirst = std::map<QChar, base::flat_set<Id>>();
+	auto uniquePrefixes = std::map<QString, base::flat_set<Id>>();
 	auto uniqueFull = std::map<Id, base::flat_set<Term>>();
 	const auto pushString = [&](
 			const Id &id,
@@ -282,7 +461,7 @@ TemplatesIndex ComputeIndex(const TemplatesData &data) {
 			int weight) {
 		const auto list = TextUtilities::PrepareSearchWords(string);
 		for (const auto &word : list) {
-			uniqueFirst[word[0]].emplace(id);
+			uniquePrefixes[word.mid(0, kPrefixLength)].emplace(id);
 			uniqueFull[id].emplace(std::make_pair(word, weight));
 		}
 	};
@@ -298,8 +477,8 @@ TemplatesIndex ComputeIndex(const TemplatesData &data) {
 	}
 
 	auto result = TemplatesIndex();
-	for (const auto &[ch, unique] : uniqueFirst) {
-		result.first.emplace(ch, unique | ranges::to_vector);
+	for (const auto &[prefix, unique] : uniquePrefixes) {
+		result.prefixes.emplace(prefix, unique | ranges::to_vector);
 	}
 	for (const auto &[id, unique] : uniqueFull) {
 		result.full.emplace(id, unique | ranges::to_vector);
@@ -307,6 +486,30 @@ TemplatesIndex ComputeIndex(const TemplatesData &data) {
 	return result;
 }
 
+FilesResult ReadFiles(const QString &folder) {
+	auto files = QDir(folder).entryList(QDir::Files);
+	files.erase(ranges::remove_if(files, [](const QString &path) {
+		return !IsTemplatesFile(path);
+	}), files.end());
+	const auto stamp = ComputeFilesStamp(folder, files);
+	if (auto cached = ReadCache(folder, stamp)) {
+		return std::move(*cached);
+	}
+	auto result = FilesResult();
+	for (const auto &path : files) {
+		auto file = ReadFile(folder + '/' + path);
+		if (!file.result.url.isEmpty() || !file.result.questions.empty()) {
+			result.result.files[path] = std::move(file.result);
+		}
+		result.errors.append(std::move(file.errors));
+	}
+	result.index = ComputeIndex(result.result);
+	if (result.errors.isEmpty()) {
+		WriteCache(folder, stamp, result);
+	}
+	return result;
+}
+
 void ReplaceFileIndex(
 		TemplatesIndex &result,
 		TemplatesIndex &&source,
@@ -323,7 +526,7 @@ void ReplaceFileIndex(
 	}
 
 	using Id = TemplatesIndex::Id;
-	for (auto &[ch, list] : result.first) {
+	for (auto &[prefix, list] : result.prefixes) {
 		auto i = ranges::lower_bound(
 			list,
 			std::make_pair(path, QString()));
@@ -332,8 +535,8 @@ void ReplaceFileIndex(
 		});
 		list.erase(i, j);
 	}
-	for (auto &[ch, list] : source.first) {
-		auto &to = result.first[ch];
+	for (auto &[prefix, list] : source.prefixes) {
+		auto &to = result.prefixes[prefix];
 		to.insert(
 			end(to),
 			std::make_move_iterator(begin(list)),
@@ -437,6 +640,35 @@ int CountMaxKeyLength(const TemplatesData &data) {
 	return result;
 }
 
+int CountCandidates(const TemplatesIndex &index, const QString &word) {
+	const auto prefix = word.mid(0, kPrefixLength);
+	auto result = 0;
+	for (auto i = index.prefixes.lower_bound(prefix)
+		; i != end(index.prefixes) && i->first.startsWith(prefix)
+		; ++i) {
+		result += int(i->second.size());
+	}
+	return result;
+}
+
+std::vector<TemplatesIndex::Id> CollectCandidates(
+		const TemplatesIndex &index,
+		const QString &word) {
+	const auto prefix = word.mid(0, kPrefixLength);
+	auto result = std::vector<TemplatesIndex::Id>();
+	for (auto i = index.prefixes.lower_bound(prefix)
+		; i != end(index.prefixes) && i->first.startsWith(prefix)
+		; ++i) {
+		result.insert(end(result), begin(i->second), end(i->second));
+	}
+	if (prefix.size() < kPrefixLength) {
+		// Several buckets were joined, the same question may repeat.
+		ranges::sort(result);
+		result.erase(ranges::unique(result), end(result));
+	}
+	return result;
+}
+
 } // namespace
 } // namespace details
 
@@ -482,13 +714,13 @@ void Templates::load() {
 
 	crl::async([=, guard = _reading.make_guard()]() mutable {
 		auto result = ReadFiles(cWorkingDir() + "TEMPLATES");
-		result.index = ComputeIndex(result.result);
 		crl::on_main(std::move(guard), [
 			=,
 			result = std::move(result)
 		]() mutable {
 			setData(std::move(result.result));
 			_index = std::move(result.index);
+			_lastQuery = LastQuery();
 			_errors.fire(std::move(result.errors));
 			crl::on_main(this, [=] {
 				if (base::take(_reloadAfterRead)) {
@@ -566,17 +798,18 @@ void Templates::updateRequestFinished(QNetworkReply *reply) {
 		auto result = ReadFromBlob(content);
 		auto one = TemplatesData();
 		one.files.emplace(path, std::move(result.result));
-		auto index = ComputeIndex(one);
 		crl::on_main(weak,[
 			=,
 			one = std::move(one),
-			errors = std::move(result.errors),
-			index = std::move(index)
+			errors = std::move(result.errors)
 		]() mutable {
 			auto &existing = _data.files.at(path);
 			auto &parsed = one.files.at(path);
 			MoveKeys(parsed, existing);
+
+			// Index after the keys are moved, they have the most weight.
 			ReplaceFileIndex(_index, ComputeIndex(one), path);
+			_lastQuery = LastQuery();
 			if (!errors.isEmpty()) {
 				_errors.fire(std::move(errors));
 			}
@@ -662,18 +895,23 @@ Templates::~Templates() = default;
 
 auto Templates::query(const QString &text) const -> std::vector<Question> {
 	const auto words = TextUtilities::PrepareSearchWords(text);
-	const auto questions = [&](const QString &word) {
-		const auto i = _index.first.find(word[0]);
-		return (i == end(_index.first)) ? 0 : i->second.size();
-	};
-	const auto best = ranges::min_element(words, std::less<>(), questions);
-	if (best == std::end(words)) {
-		return {};
-	}
-	const auto narrowed = _index.first.find((*best)[0]);
-	if (narrowed == end(_index.first)) {
+	if (words.isEmpty()) {
+		_lastQuery = LastQuery();
 		return {};
 	}
+
+	// Typing more letters can only drop questions from the previous
+	// results, so while the query grows we rescore only those.
+	const auto narrowing = !_lastQuery.text.isEmpty()
+		&& text.startsWith(_lastQuery.text);
+	auto candidates = narrowing
+		? base::take(_lastQuery.matched)
+		: CollectCandidates(
+			_index,
+			*ranges::min_element(words, std::less<>(), [&](
+					const QString &word) {
+				return CountCandidates(_index, word);
+			}));
 	using Id = TemplatesIndex::Id;
 	using Term = TemplatesIndex::Term;
 	const auto questionById = [&](const Id &id) {
@@ -726,11 +964,15 @@ auto Templates::query(const QString &text) const -> std::vector<Question> {
 			return (a.first.second < b.first.second);
 		}
 	};
-	const auto good = narrowed->second | ranges::views::transform(
+	const auto good = candidates | ranges::views::transform(
 		pairById
 	) | ranges::views::filter([](const Pair &pair) {
 		return pair.second > 0;
 	}) | ranges::to_vector | ranges::actions::stable_sort(sorter);
+	_lastQuery.text = text;
+	_lastQuery.matched = good | ranges::views::transform(
+		&Pair::first
+	) | ranges::to_vector;
 	return good | ranges::views::transform([&](const Pair &pair) {
 		return questionById(pair.first);
 	}) | ranges::views::take(kQueryLimit) | ranges::to_vector;
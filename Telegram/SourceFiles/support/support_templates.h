@@ -38,7 +38,7 @@ struct TemplatesIndex {
 	using Id = std::pair<QString, QString>; // filename, normalized question
 	using Term = std::pair<QString, int>; // search term, weight
 
-	std::map<QChar, std::vector<Id>> first;
+	std::map<QString, std::vector<Id>> prefixes; // Up to two letters.
 	std::map<Id, std::vector<Term>> full;
 };
 
@@ -71,6 +71,10 @@ public:
 
 private:
 	struct Updates;
+	struct LastQuery {
+		QString text;
+		std::vector<details::TemplatesIndex::Id> matched;
+	};
 
 	void load();
 	void update();
@@ -83,6 +87,7 @@ private:
 
 	details::TemplatesData _data;
 	details::TemplatesIndex _index;
+	mutable LastQuery _lastQuery;
 	rpl::event_stream<QStringList> _errors;
 	base::binary_guard _reading;
 	bool _reloadAfterRead = false;
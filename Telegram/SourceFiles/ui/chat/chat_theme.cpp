@@ -20,6 +20,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "ui/style/style_palette_colorizer.h"
 
 #include <crl/crl_async.h>
+#include <QtCore/QMutex>
 #include <QtGui/QGuiApplication>
 
 namespace Ui {
@@ -32,6 +33,104 @@ constexpr auto kMinimumTiledSize = 512;
 constexpr auto kMaxSize = 2960;
 constexpr auto kMaxContrastValue = 21.;
 constexpr auto kMinAcceptableContrast = 1.14;// 4.5;
+constexpr auto kMaxCachedBackgroundSizes = 2;
+
+// Everything CacheBackgroundByRequest() result depends on.
+struct CachedBackgroundKey {
+	explicit CachedBackgroundKey(const CacheBackgroundRequest &request)
+	: key(request.background.key)
+	, prepared(request.background.prepared.cacheKey())
+	, preparedForTiled(request.background.preparedForTiled.cacheKey())
+	, gradientForFill(request.background.gradientForFill.cacheKey())
+	, giftSymbolFrame(request.background.giftSymbolFrame.cacheKey())
+	, colors(request.background.colors)
+	, area(request.area)
+	, ratio(style::DevicePixelRatio())
+	, gradientRotation(request.background.gradientRotation)
+	, gradientRotationAdd(request.gradientRotationAdd)
+	, patternOpacity(request.background.patternOpacity)
+	, giftId(request.background.giftId)
+	, isPattern(request.background.isPattern)
+	, tile(request.background.tile) {
+		const auto &symbols = request.background.giftSymbols;
+		giftSymbols.reserve(symbols.size());
+		for (const auto &symbol : symbols) {
+			giftSymbols.emplace_back(symbol.area, symbol.rotation);
+		}
+	}
+
+	QString key;
+	qint64 prepared = 0;
+	qint64 preparedForTiled = 0;
+	qint64 gradientForFill = 0;
+	qint64 giftSymbolFrame = 0;
+	std::vector<QColor> colors;
+	QSize area;
+	int ratio = 0;
+	int gradientRotation = 0;
+	int gradientRotationAdd = 0;
+	float64 patternOpacity = 1.;
+	std::vector<std::pair<QRectF, float64>> giftSymbols;
+	uint64 giftId = 0;
+	bool isPattern = false;
+	bool tile = false;
+
+	[[nodiscard]] bool sameBackground(
+			const CachedBackgroundKey &other) const {
+		return (key == other.key)
+			&& (prepared == other.prepared)
+			&& (gradientForFill == other.gradientForFill);
+	}
+
+	friend inline bool operator==(
+		const CachedBackgroundKey &,
+		const CachedBackgroundKey &) = default;
+};
+
+struct CachedBackgroundEntry {
+	CachedBackgroundKey key;
+	CacheBackgroundResult result;
+};
+
+// Backgrounds shown by chat themes, most recently used first. Chats with
+// the same theme and resizing the window back to the previous size reuse
+// these pixmaps. They are shared with the themes showing them, so only
+// the previous size of a shown background takes additional memory.
+struct CachedBackgrounds {
+	std::vector<CachedBackgroundEntry> list;
+	QMutex mutex;
+};
+
+[[nodiscard]] CachedBackgrounds &GlobalCachedBackgrounds() {
+	static auto result = CachedBackgrounds();
+	return result;
+}
+
+// Keeps the two most recent sizes of each background while it is shown.
+void ShrinkCachedBackgrounds(CachedBackgrounds &cache) {
+	auto &list = cache.list;
+	const auto shown = [&](const CachedBackgroundKey &key) {
+		return ranges::any_of(list, [&](const CachedBackgroundEntry &entry) {
+			return entry.key.sameBackground(key)
+				&& !entry.result.pixmap.isDetached();
+		});
+	};
+	auto kept = std::vector<const CachedBackgroundKey*>();
+	for (const auto &entry : list) {
+		const auto &key = entry.key;
+		const auto sizes = ranges::count_if(kept, [&](
+				const CachedBackgroundKey *other) {
+			return other->sameBackground(key);
+		});
+		if (sizes < kMaxCachedBackgroundSizes && shown(key)) {
+			kept.push_back(&key);
+		}
+	}
+	list.erase(ranges::remove_if(list, [&](
+			const CachedBackgroundEntry &entry) {
+		return ranges::find(kept, &entry.key) == end(kept);
+	}), end(list));
+}
 
 [[nodiscard]] QColor DefaultBackgroundColor() {
 	return QColor(213, 223, 233);
@@ -217,8 +316,8 @@ constexpr auto kMinAcceptableContrast = 1.14;// 4.5;
 			}
 		}
 		return {
-			.image = std::move(result).convertToFormat(
-				QImage::Format_ARGB32_Premultiplied),
+			.pixmap = PixmapFromImage(std::move(result).convertToFormat(
+				QImage::Format_ARGB32_Premultiplied)),
 			.gradient = gradient,
 			.area = request.area,
 			.giftArea = giftArea,
@@ -237,8 +336,8 @@ constexpr auto kMinAcceptableContrast = 1.14;// 4.5;
 			Qt::SmoothTransformation);
 		result.setDevicePixelRatio(style::DevicePixelRatio());
 		return {
-			.image = std::move(result).convertToFormat(
-				QImage::Format_ARGB32_Premultiplied),
+			.pixmap = PixmapFromImage(std::move(result).convertToFormat(
+				QImage::Format_ARGB32_Premultiplied)),
 			.gradient = gradient,
 			.area = request.area,
 			.x = rects.to.x(),
@@ -287,11 +386,29 @@ bool operator!=(
 
 CacheBackgroundResult CacheBackground(
 		const CacheBackgroundRequest &request) {
-	return CacheBackgroundByRequest(request);
+	auto key = CachedBackgroundKey(request);
+	auto &cache = GlobalCachedBackgrounds();
+	auto lock = QMutexLocker(&cache.mutex);
+	const auto i = ranges::find(cache.list, key, &CachedBackgroundEntry::key);
+	if (i != end(cache.list)) {
+		std::rotate(begin(cache.list), i, i + 1);
+		return cache.list.front().result;
+	}
+	lock.unlock();
+
+	auto result = CacheBackgroundByRequest(request);
+
+	lock.relock();
+	cache.list.insert(begin(cache.list), CachedBackgroundEntry{
+		.key = std::move(key),
+		.result = result,
+	});
+	ShrinkCachedBackgrounds(cache);
+	return result;
 }
 
 CachedBackground::CachedBackground(CacheBackgroundResult &&result)
-: pixmap(PixmapFromImage(std::move(result.image)))
+: pixmap(std::move(result.pixmap))
 , area(result.area)
 , x(result.x)
 , y(result.y)
@@ -313,7 +430,16 @@ ChatTheme::ChatTheme(ChatThemeDescriptor &&descriptor)
 	adjustPalette(descriptor);
 }
 
-ChatTheme::~ChatTheme() = default;
+ChatTheme::~ChatTheme() {
+	clearBackgroundState();
+	_backgroundNext = {};
+	_bubblesBackground = {};
+	_bubblesBackgroundPattern = nullptr;
+
+	auto &cache = GlobalCachedBackgrounds();
+	auto lock = QMutexLocker(&cache.mutex);
+	ShrinkCachedBackgrounds(cache);
+}
 
 void ChatTheme::adjustPalette(const ChatThemeDescriptor &descriptor) {
 	auto &p = *_palette;
@@ -636,7 +762,7 @@ bool ChatTheme::readyForBackgroundRotation() const {
 void ChatTheme::generateNextBackgroundRotation() {
 	if (_nextCachingRequest
 		|| _backgroundCachingRequest
-		|| !_backgroundNext.image.isNull()
+		|| !_backgroundNext.pixmap.isNull()
 		|| !readyForBackgroundRotation()
 		|| background().colors.size() < 3) {
 		return;
@@ -818,7 +944,7 @@ rpl::producer<> ChatTheme::repaintBackgroundRequests() const {
 }
 
 void ChatTheme::rotateComplexGradientBackground() {
-	if (!_backgroundFade.animating() && !_backgroundNext.image.isNull()) {
+	if (!_backgroundFade.animating() && !_backgroundNext.pixmap.isNull()) {
 		if (_mutableBackground.gradientForFill.size()
 			== _backgroundNext.gradient.size()) {
 			_mutableBackground.gradientForFill
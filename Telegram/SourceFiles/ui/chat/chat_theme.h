@@ -96,7 +96,7 @@ bool operator!=(
 	const CacheBackgroundRequest &b);
 
 struct CacheBackgroundResult {
-	QImage image;
+	QPixmap pixmap;
 	QImage gradient;
 	QSize area;
 	int x = 0;
@@ -61,6 +61,11 @@ constexpr auto kMinimalAlertDelay = crl::time(500);
 constexpr auto kWaitingForAllGroupedDelay = crl::time(1000);
 constexpr auto kReactionNotificationEach = 60 * 60 * crl::time(1000);
 
+// more than 3 toasts in 5s from one chat - the rest is shown as a summary
+constexpr auto kBurstWindow = 5 * crl::time(1000);
+constexpr auto kBurstLimit = 3;
+constexpr auto kLogEachProcessed = 1000;
+
 #ifdef Q_OS_MAC
 constexpr auto kSystemAlertDuration = crl::time(1000);
 #else // !Q_OS_MAC
@@ -409,6 +414,9 @@ void System::schedule(Data::ItemNotification notification) {
 	const auto item = notification.item;
 	const auto type = notification.type;
 	const auto thread = item->notificationThread();
+	if (!(++_processedCount % kLogEachProcessed)) {
+		logCounters();
+	}
 	const auto skip = skipNotification(notification);
 	if (skip.value == SkipState::Skip) {
 		thread->popNotification(notification);
@@ -476,6 +484,7 @@ void System::clearAll() {
 	_whenAlerts.clear();
 	_waiters.clear();
 	_settingWaiters.clear();
+	_bursts.clear();
 	_watchedTopics.clear();
 	_watchedSublists.clear();
 }
@@ -490,6 +499,7 @@ void System::clearFromTopic(not_null<Data::ForumTopic*> topic) {
 	_whenAlerts.remove(topic);
 	_waiters.remove(topic);
 	_settingWaiters.remove(topic);
+	_bursts.remove(topic);
 
 	_watchedTopics.remove(topic);
 
@@ -507,6 +517,7 @@ void System::clearFromSublist(not_null<Data::SavedSublist*> sublist) {
 	_whenAlerts.remove(sublist);
 	_waiters.remove(sublist);
 	_settingWaiters.remove(sublist);
+	_bursts.remove(sublist);
 
 	_watchedSublists.remove(sublist);
 
@@ -527,6 +538,7 @@ void System::clearForThreadIf(Fn<bool(not_null<Data::Thread*>)> predicate) {
 		_whenAlerts.remove(thread);
 		_waiters.remove(thread);
 		_settingWaiters.remove(thread);
+		_bursts.remove(thread);
 		if (const auto topic = thread->asTopic()) {
 			_watchedTopics.remove(topic);
 		} else if (const auto sublist = thread->asSublist()) {
@@ -551,6 +563,7 @@ void System::clearForThreadIf(Fn<bool(not_null<Data::Thread*>)> predicate) {
 	clearFrom(_whenAlerts);
 	clearFrom(_waiters);
 	clearFrom(_settingWaiters);
+	clearFrom(_bursts);
 
 	_waitTimer.cancel();
 	showNext();
@@ -614,6 +627,7 @@ void System::clearAllFast() {
 	_whenAlerts.clear();
 	_waiters.clear();
 	_settingWaiters.clear();
+	_bursts.clear();
 	_watchedTopics.clear();
 	_watchedSublists.clear();
 }
@@ -658,6 +672,7 @@ void System::showGrouped() {
 	if (const auto session = findSession(_lastHistorySessionId)) {
 		if (const auto lastItem = session->data().message(_lastHistoryItemId)) {
 			_waitForAllGroupedTimer.cancel();
+			++_shownCount;
 			_manager->showNotification({
 				.item = lastItem,
 				.forwardedCount = _lastForwardedCount,
@@ -793,7 +808,9 @@ void System::showNext() {
 				i = _waiters.erase(i);
 				continue;
 			}
-			auto when = i->second.when;
+			const auto when = std::max(
+				i->second.when,
+				burstDelayedTill(thread, ms));
 			if (!notify || next > when) {
 				next = when;
 				notify = current,
@@ -819,6 +836,71 @@ void System::showNext() {
 			&& notifyItem->Has<HistoryMessageForwarded>();
 		const auto isAlbum = messageType
 			&& notifyItem->groupId();
+		const auto thread = notifyItem->notificationThread();
+
+		// A chat that was showing toasts too often gets one summary
+		// toast for everything that arrived while it was held back.
+		if (messageType
+			&& !isForwarded
+			&& !isAlbum
+			&& burstDelayedTill(thread, ms)) {
+			auto lastItem = notifyItem;
+			auto count = 0;
+			const auto j = _whenMaps.find(thread);
+			while (thread->hasNotification()) {
+				const auto current = thread->currentNotification();
+				if (current->type != Data::ItemNotificationType::Message) {
+					// Reactions are left for the usual path below.
+					break;
+				} else if (j != _whenMaps.end()) {
+					const auto k = j->second.find(*current);
+					if (k != j->second.end()) {
+						j->second.erase(k);
+						lastItem = current->item;
+						++count;
+					}
+				}
+				thread->skipNotification();
+			}
+			_waiters.remove(thread);
+			if (j == _whenMaps.end()) {
+				thread->clearNotifications();
+			} else {
+				while (thread->hasNotification()) {
+					const auto k = j->second.find(
+						thread->currentNotification());
+					if (k != j->second.cend()) {
+						_waiters.emplace(thread, Waiter{
+							.key = k->first,
+							.when = k->second
+						});
+						break;
+					}
+					thread->skipNotification();
+				}
+				if (!thread->hasNotification()) {
+					_whenMaps.erase(j);
+				}
+			}
+
+			showGrouped();
+			++_shownCount;
+			_coalescedCount += std::max(count - 1, 0);
+			_manager->showNotification({
+				.item = lastItem,
+				.burstCount = count,
+				.soundId = (notifySilent
+					? std::nullopt
+					: MaybeSoundFor(
+						notifyThread,
+						lastItem->specialNotificationPeer())),
+			});
+
+			// Keep summarizing while the chat stays that busy.
+			_bursts[thread] = { .windowStart = ms, .shown = kBurstLimit };
+			continue;
+		}
+		countShown(thread, ms);
 
 		// Forwarded and album notify grouping.
 		auto groupedItem = (isForwarded || isAlbum)
@@ -826,7 +908,6 @@ void System::showNext() {
 			: nullptr;
 		auto forwardedCount = isForwarded ? 1 : 0;
 
-		const auto thread = notifyItem->notificationThread();
 		const auto j = _whenMaps.find(thread);
 		if (j == _whenMaps.cend()) {
 			thread->clearNotifications();
@@ -928,6 +1009,7 @@ void System::showNext() {
 				? notify->reactionSender
 				: notify->item->specialNotificationPeer();
 			if (!reactionNotification || !reaction.empty()) {
+				++_shownCount;
 				_manager->showNotification({
 					.item = notify->item,
 					.forwardedCount = forwardedCount,
@@ -950,6 +1032,40 @@ void System::showNext() {
 	}
 }
 
+crl::time System::burstDelayedTill(
+		not_null<Data::Thread*> thread,
+		crl::time now) const {
+	const auto i = _bursts.find(thread);
+	if (i == end(_bursts) || i->second.shown < kBurstLimit) {
+		return 0;
+	}
+	// Nothing arrived during the whole next window, the burst is over.
+	const auto till = i->second.windowStart + kBurstWindow;
+	return (now - till < kBurstWindow) ? till : 0;
+}
+
+void System::countShown(not_null<Data::Thread*> thread, crl::time now) {
+	for (auto i = begin(_bursts); i != end(_bursts);) {
+		if (now - i->second.windowStart >= 2 * kBurstWindow) {
+			i = _bursts.erase(i);
+		} else {
+			++i;
+		}
+	}
+	auto &burst = _bursts[thread];
+	if (now - burst.windowStart >= kBurstWindow) {
+		burst = { .windowStart = now };
+	}
+	++burst.shown;
+}
+
+void System::logCounters() const {
+	DEBUG_LOG(("Notifications: %1 processed, %2 shown, %3 summarized."
+		).arg(_processedCount
+		).arg(_shownCount
+		).arg(_coalescedCount));
+}
+
 QByteArray System::lookupSoundBytes(
 		not_null<Data::Session*> owner,
 		DocumentId id) {
@@ -1452,6 +1568,8 @@ void NativeManager::doShowNotification(NotificationFields &&fields) {
 			options.hideMessageText))
 		: options.hideMessageText
 		? tr::lng_notification_preview(tr::now)
+		: (fields.burstCount > 1)
+		? tr::lng_notification_messages(tr::now, lt_count, fields.burstCount)
 		: (fields.forwardedCount > 1)
 		? tr::lng_forward_messages(tr::now, lt_count, fields.forwardedCount)
 		: item->groupId()
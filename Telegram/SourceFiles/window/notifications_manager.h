@@ -175,6 +175,10 @@ private:
 		crl::time delay = 0;
 		crl::time when = 0;
 	};
+	struct Burst {
+		crl::time windowStart = 0;
+		int shown = 0;
+	};
 	struct ReactionNotificationId {
 		FullMsgId itemId;
 		uint64 sessionId = 0;
@@ -199,6 +203,12 @@ private:
 	[[nodiscard]] bool skipReactionNotification(
 		not_null<HistoryItem*> item) const;
 
+	[[nodiscard]] crl::time burstDelayedTill(
+		not_null<Data::Thread*> thread,
+		crl::time now) const;
+	void countShown(not_null<Data::Thread*> thread, crl::time now);
+	void logCounters() const;
+
 	void showNext();
 	void showGrouped();
 	void ensureSoundCreated();
@@ -221,6 +231,11 @@ private:
 		not_null<Data::Thread*>,
 		base::flat_map<crl::time, PeerData*>> _whenAlerts;
 
+	base::flat_map<not_null<Data::Thread*>, Burst> _bursts;
+	int64 _processedCount = 0;
+	int64 _shownCount = 0;
+	int64 _coalescedCount = 0;
+
 	mutable base::flat_map<
 		ReactionNotificationId,
 		crl::time> _sentReactionNotifications;
@@ -274,6 +289,7 @@ public:
 	struct NotificationFields {
 		not_null<HistoryItem*> item;
 		int forwardedCount = 0;
+		int burstCount = 0;
 		PeerData *reactionFrom = nullptr;
 		Data::ReactionId reactionId;
 		std::optional<DocumentId> soundId;
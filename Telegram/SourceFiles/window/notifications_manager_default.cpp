@@ -93,6 +93,7 @@ Manager::QueuedNotification::QueuedNotification(NotificationFields &&fields)
 	: QString())
 , item((fields.forwardedCount < 2) ? fields.item.get() : nullptr)
 , forwardedCount(fields.forwardedCount)
+, burstCount(fields.burstCount)
 , fromScheduled(reaction.empty() && (fields.item->out() || peer->isSelf())
 	&& fields.item->isFromScheduled()) {
 }
@@ -240,6 +241,7 @@ void Manager::showNextFromQueue() {
 			queued.item,
 			queued.reaction,
 			queued.forwardedCount,
+			queued.burstCount,
 			queued.fromScheduled,
 			startPosition,
 			startShift,
@@ -641,6 +643,7 @@ Notification::Notification(
 	HistoryItem *item,
 	const Data::ReactionId &reaction,
 	int forwardedCount,
+	int burstCount,
 	bool fromScheduled,
 	QPoint startPosition,
 	int shift,
@@ -658,6 +661,7 @@ Notification::Notification(
 , _reaction(reaction)
 , _item(item)
 , _forwardedCount(forwardedCount)
+, _burstCount(burstCount)
 , _fromScheduled(fromScheduled)
 , _close(this, st::notifyClose)
 , _reply(this, tr::lng_notification_reply(), st::defaultBoxButton) {
@@ -946,6 +950,11 @@ void Notification::updateNotifyDisplay() {
 					_item,
 					_reaction,
 					options.hideMessageText))
+				: (_item && _burstCount > 1)
+				? TextWithEntities{ tr::lng_notification_messages(
+					tr::now,
+					lt_count,
+					_burstCount) }
 				: _item
 				? _item->toPreview({
 					.hideSender = reminder,